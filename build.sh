@@ -23,12 +23,13 @@ export BUILD_PATH="${BASEPATH}/build/"
 usage()
 {
   echo "Usage:"
-  echo "sh build.sh [-j[n]] [-h] [-v] [-s] [-t] [-u] [-c] [-S on|off]"
+  echo "sh build.sh [-j[n]] [-h] [-v] [-s] [-b] [-t] [-u] [-c] [-S on|off]"
   echo ""
   echo "Options:"
   echo "    -h Print usage"
   echo "    -u Only compile ut, not execute"
   echo "    -s Build st"
+  echo "    -b Build parser_benchmark"
   echo "    -j[n] Set the number of threads used for building Parser, default is 8"
   echo "    -t Build and execute ut"
   echo "    -c Build ut with coverage tag"
@@ -57,10 +58,11 @@ checkopts()
   ENABLE_GE_UT="off"
   ENABLE_GE_ST="off"
   ENABLE_GE_COV="off"
+  ENABLE_PARSER_BENCHMARK="off"
   GE_ONLY="on"
   ENABLE_GITEE="off"
   # Process the options
-  while getopts 'ustchj:vS:' opt
+  while getopts 'ustbchj:vS:' opt
   do
     OPTARG=$(echo ${OPTARG} | tr '[A-Z]' '[a-z]')
     case "${opt}" in
@@ -72,6 +74,9 @@ checkopts()
       s)
         ENABLE_GE_ST="on"
         ;;
+      b)
+        ENABLE_PARSER_BENCHMARK="on"
+        ;;
       t)
 	      ENABLE_GE_UT="on"
 	      GE_ONLY="off"
@@ -137,6 +142,10 @@ build_parser()
     CMAKE_ARGS="${CMAKE_ARGS} -DENABLE_GE_ST=ON"
   fi
 
+  if [[ "X$ENABLE_PARSER_BENCHMARK" = "Xon" ]]; then
+    CMAKE_ARGS="${CMAKE_ARGS} -DENABLE_PARSER_BENCHMARK=ON"
+  fi
+
   if [[ "X$ENABLE_GITEE" = "Xon" ]]; then
     CMAKE_ARGS="${CMAKE_ARGS} -DENABLE_GITEE=ON"
   fi
@@ -0,0 +1,303 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/benchmark/model_generator.h"
+
+#include <fstream>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "google/protobuf/text_format.h"
+#include "proto/caffe/caffe.pb.h"
+#include "proto/onnx/ge_onnx.pb.h"
+#include "proto/tensorflow/graph.pb.h"
+#include "proto/tensorflow/graph_library.pb.h"
+
+namespace ge {
+namespace parser {
+namespace {
+const char *const kInputName = "input";
+const char *const kFuncDefLibraryFile = "graph_def_library.pbtxt";
+
+// Portable LCG, std distributions differ between standard libraries and would break reproducibility
+class WeightGenerator {
+ public:
+  explicit WeightGenerator(uint32_t seed) : state_(seed) {}
+  void Fill(uint32_t count, std::vector<float> &values) {
+    values.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      state_ = state_ * 1664525U + 1013904223U;
+      values[i] = static_cast<float>(state_ >> 8) / static_cast<float>(1U << 24) - 0.5f;
+    }
+  }
+
+ private:
+  uint32_t state_;
+};
+
+uint32_t GetChannel(const ModelSpec &spec) { return spec.const_elems > 0 ? spec.const_elems : spec.channel; }
+
+std::string GetNodeName(uint32_t index) { return "node_" + std::to_string(index); }
+
+// Nodes form a tree of degree fan_out, node 0 consumes the model input
+std::string GetParentName(const ModelSpec &spec, uint32_t index) {
+  if (index == 0) {
+    return kInputName;
+  }
+  uint32_t fan_out = spec.fan_out == 0 ? 1 : spec.fan_out;
+  return GetNodeName((index - 1) / fan_out);
+}
+
+bool IsLeaf(const ModelSpec &spec, uint32_t index) {
+  uint32_t fan_out = spec.fan_out == 0 ? 1 : spec.fan_out;
+  return static_cast<uint64_t>(index) * fan_out + 1 >= spec.node_num;
+}
+
+// Spread function calls evenly over the graph
+bool IsFunctionCall(const ModelSpec &spec, uint32_t index) {
+  if (spec.function_num == 0) {
+    return false;
+  }
+  uint32_t stride = spec.node_num / spec.function_num;
+  stride = stride == 0 ? 1 : stride;
+  return (index % stride == stride - 1) && (index / stride < spec.function_num);
+}
+
+Status WriteBinaryProto(const google::protobuf::Message &message, const std::string &file) {
+  std::ofstream fs(file, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fs.is_open() || !message.SerializeToOstream(&fs)) {
+    GELOGE(FAILED, "Write proto to file %s failed.", file.c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+Status WriteTextProto(const google::protobuf::Message &message, const std::string &file) {
+  std::string text;
+  if (!google::protobuf::TextFormat::PrintToString(message, &text)) {
+    GELOGE(FAILED, "Print proto of file %s failed.", file.c_str());
+    return FAILED;
+  }
+  std::ofstream fs(file, std::ios::out | std::ios::trunc);
+  if (!fs.is_open() || !(fs << text)) {
+    GELOGE(FAILED, "Write text to file %s failed.", file.c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+void SetTfTypeAttr(domi::tensorflow::NodeDef *node_def, const std::string &attr_name) {
+  (*node_def->mutable_attr())[attr_name].set_type(domi::tensorflow::DT_FLOAT);
+}
+
+void SetTfTypeListAttr(domi::tensorflow::NodeDef *node_def, const std::string &attr_name) {
+  (*node_def->mutable_attr())[attr_name].mutable_list()->add_type(domi::tensorflow::DT_FLOAT);
+}
+
+domi::tensorflow::NodeDef *AddTfNode(domi::tensorflow::GraphDef &graph_def, const std::string &name,
+                                     const std::string &op, const std::string &input) {
+  domi::tensorflow::NodeDef *node_def = graph_def.add_node();
+  node_def->set_name(name);
+  node_def->set_op(op);
+  if (!input.empty()) {
+    node_def->add_input(input);
+  }
+  return node_def;
+}
+
+void AddTfFunction(const ModelSpec &spec, const std::string &func_name, domi::tensorflow::GraphDef &graph_def,
+                   domi::tensorflow::GraphDefLibrary &graph_def_library) {
+  // Declaration in the library of the model, so that the parser looks for graph_def_library.pbtxt
+  domi::tensorflow::FunctionDef *func_def = graph_def.mutable_library()->add_function();
+  domi::tensorflow::OpDef *signature = func_def->mutable_signature();
+  signature->set_name(func_name);
+  domi::tensorflow::OpDef::ArgDef *input_arg = signature->add_input_arg();
+  input_arg->set_name("x");
+  input_arg->set_type(domi::tensorflow::DT_FLOAT);
+  domi::tensorflow::OpDef::ArgDef *output_arg = signature->add_output_arg();
+  output_arg->set_name("y");
+  output_arg->set_type(domi::tensorflow::DT_FLOAT);
+
+  // Body as func2graph.py saves it: _Arg -> Relu * n -> _Retval
+  domi::tensorflow::GeGraphDef *ge_graph_def = graph_def_library.add_graph_def();
+  ge_graph_def->set_name(func_name);
+  domi::tensorflow::GraphDef *body = ge_graph_def->mutable_graph();
+  domi::tensorflow::NodeDef *arg = AddTfNode(*body, "x", "_Arg", "");
+  SetTfTypeAttr(arg, "T");
+  (*arg->mutable_attr())["index"].set_i(0);
+  std::string last_name = arg->name();
+  for (uint32_t i = 0; i < spec.function_body_nodes; ++i) {
+    std::string relu_name = "relu_" + std::to_string(i);
+    SetTfTypeAttr(AddTfNode(*body, relu_name, "Relu", last_name), "T");
+    last_name = relu_name;
+  }
+  (*func_def->mutable_ret())["y"] = (spec.function_body_nodes == 0) ? "x" : last_name + ":activations:0";
+  domi::tensorflow::NodeDef *retval = AddTfNode(*body, "y", "_Retval", last_name);
+  SetTfTypeAttr(retval, "T");
+  (*retval->mutable_attr())["index"].set_i(0);
+}
+}  // namespace
+
+Status GenerateTensorFlowModel(const ModelSpec &spec, const std::string &model_file) {
+  uint32_t channel = GetChannel(spec);
+  WeightGenerator weight_generator(spec.seed);
+  std::vector<float> weights;
+  domi::tensorflow::GraphDef graph_def;
+  domi::tensorflow::GraphDefLibrary graph_def_library;
+
+  domi::tensorflow::NodeDef *input = AddTfNode(graph_def, kInputName, "Placeholder", "");
+  SetTfTypeAttr(input, "dtype");
+  domi::tensorflow::TensorShapeProto *input_shape = (*input->mutable_attr())["shape"].mutable_shape();
+  input_shape->add_dim()->set_size(1);
+  input_shape->add_dim()->set_size(channel);
+
+  for (uint32_t i = 0; i < spec.node_num; ++i) {
+    std::string node_name = GetNodeName(i);
+    std::string parent_name = GetParentName(spec, i);
+    if (IsFunctionCall(spec, i)) {
+      std::string func_name = "func_" + std::to_string(i);
+      AddTfFunction(spec, func_name, graph_def, graph_def_library);
+      domi::tensorflow::NodeDef *call = AddTfNode(graph_def, node_name, "PartitionedCall", parent_name);
+      (*call->mutable_attr())["f"].mutable_func()->set_name(func_name);
+      SetTfTypeListAttr(call, "Tin");
+      SetTfTypeListAttr(call, "Tout");
+    } else if (spec.const_elems > 0) {
+      std::string weight_name = node_name + "/weight";
+      domi::tensorflow::NodeDef *weight = AddTfNode(graph_def, weight_name, "Const", "");
+      SetTfTypeAttr(weight, "dtype");
+      domi::tensorflow::TensorProto *tensor = (*weight->mutable_attr())["value"].mutable_tensor();
+      tensor->set_dtype(domi::tensorflow::DT_FLOAT);
+      tensor->mutable_tensor_shape()->add_dim()->set_size(channel);
+      weight_generator.Fill(channel, weights);
+      tensor->set_tensor_content(weights.data(), weights.size() * sizeof(float));
+      domi::tensorflow::NodeDef *add = AddTfNode(graph_def, node_name, "Add", parent_name);
+      add->add_input(weight_name);
+      SetTfTypeAttr(add, "T");
+    } else {
+      SetTfTypeAttr(AddTfNode(graph_def, node_name, "Relu", parent_name), "T");
+    }
+  }
+  GELOGI("Generated tensorflow model of %d nodes and %d functions.", graph_def.node_size(),
+         graph_def.library().function_size());
+
+  GE_RETURN_IF_ERROR(WriteBinaryProto(graph_def, model_file));
+  if (graph_def_library.graph_def_size() > 0) {
+    size_t pos = model_file.rfind('/');
+    std::string library_file =
+        (pos == std::string::npos) ? kFuncDefLibraryFile : model_file.substr(0, pos) + "/" + kFuncDefLibraryFile;
+    GE_RETURN_IF_ERROR(WriteTextProto(graph_def_library, library_file));
+  }
+  return SUCCESS;
+}
+
+Status GenerateCaffeModel(const ModelSpec &spec, const std::string &model_file, const std::string &weights_file) {
+  uint32_t channel = GetChannel(spec);
+  WeightGenerator weight_generator(spec.seed);
+  std::vector<float> weights;
+  domi::caffe::NetParameter net;
+  domi::caffe::NetParameter weights_net;
+  net.set_name("parser_benchmark");
+  weights_net.set_name("parser_benchmark");
+
+  domi::caffe::LayerParameter *input = net.add_layer();
+  input->set_name(kInputName);
+  input->set_type("Input");
+  input->add_top(kInputName);
+  domi::caffe::BlobShape *input_shape = input->mutable_input_param()->add_shape();
+  input_shape->add_dim(1);
+  input_shape->add_dim(channel);
+  input_shape->add_dim(1);
+  input_shape->add_dim(1);
+  *weights_net.add_layer() = *input;
+
+  for (uint32_t i = 0; i < spec.node_num; ++i) {
+    domi::caffe::LayerParameter *layer = net.add_layer();
+    layer->set_name(GetNodeName(i));
+    layer->add_bottom(GetParentName(spec, i));
+    layer->add_top(GetNodeName(i));
+    if (spec.const_elems == 0) {
+      layer->set_type("ReLU");
+      *weights_net.add_layer() = *layer;
+      continue;
+    }
+    // Per channel scale, its blob carries const_elems floats
+    layer->set_type("Scale");
+    layer->mutable_scale_param()->set_bias_term(false);
+    domi::caffe::LayerParameter *weights_layer = weights_net.add_layer();
+    *weights_layer = *layer;
+    domi::caffe::BlobProto *blob = weights_layer->add_blobs();
+    blob->mutable_shape()->add_dim(channel);
+    weight_generator.Fill(channel, weights);
+    blob->mutable_data()->Reserve(static_cast<int>(channel));
+    for (float value : weights) {
+      blob->add_data(value);
+    }
+  }
+  GELOGI("Generated caffe model of %d layers.", net.layer_size());
+
+  GE_RETURN_IF_ERROR(WriteTextProto(net, model_file));
+  return WriteBinaryProto(weights_net, weights_file);
+}
+
+Status GenerateOnnxModel(const ModelSpec &spec, const std::string &model_file) {
+  uint32_t channel = GetChannel(spec);
+  WeightGenerator weight_generator(spec.seed);
+  std::vector<float> weights;
+  ge::onnx::ModelProto model;
+  model.set_ir_version(7);
+  model.set_producer_name("parser_benchmark");
+  ge::onnx::OperatorSetIdProto *opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(11);
+
+  ge::onnx::GraphProto *graph = model.mutable_graph();
+  graph->set_name("parser_benchmark");
+  ge::onnx::TypeProto_Tensor *input_type = graph->add_input()->mutable_type()->mutable_tensor_type();
+  graph->mutable_input(0)->set_name(kInputName);
+  input_type->set_elem_type(ge::onnx::TensorProto_DataType_FLOAT);
+  input_type->mutable_shape()->add_dim()->set_dim_value(1);
+  input_type->mutable_shape()->add_dim()->set_dim_value(channel);
+
+  for (uint32_t i = 0; i < spec.node_num; ++i) {
+    std::string node_name = GetNodeName(i);
+    ge::onnx::NodeProto *node = graph->add_node();
+    node->set_name(node_name);
+    node->add_input(GetParentName(spec, i));
+    node->add_output(node_name);
+    if (spec.const_elems == 0) {
+      node->set_op_type("Relu");
+    } else {
+      std::string weight_name = node_name + "_weight";
+      node->set_op_type("Add");
+      node->add_input(weight_name);
+      ge::onnx::TensorProto *initializer = graph->add_initializer();
+      initializer->set_name(weight_name);
+      initializer->set_data_type(ge::onnx::TensorProto_DataType_FLOAT);
+      initializer->add_dims(channel);
+      weight_generator.Fill(channel, weights);
+      initializer->set_raw_data(weights.data(), weights.size() * sizeof(float));
+    }
+    if (IsLeaf(spec, i)) {
+      graph->add_output()->set_name(node_name);
+    }
+  }
+  GELOGI("Generated onnx model of %d nodes and %d initializers.", graph->node_size(), graph->initializer_size());
+
+  return WriteBinaryProto(model, model_file);
+}
+}  // namespace parser
+}  // namespace ge
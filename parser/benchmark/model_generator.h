@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_BENCHMARK_MODEL_GENERATOR_H_
+#define PARSER_BENCHMARK_MODEL_GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "external/ge/ge_api_error_codes.h"
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Shape of a synthetic model. The same spec and seed always produce the same bytes.
+///
+struct ModelSpec {
+  // number of compute nodes, inputs and weights not included
+  uint32_t node_num = 10000;
+  // consumers of every node output, the graph is a tree of this degree below the input
+  uint32_t fan_out = 1;
+  // float elements of the weight owned by every compute node, 0 means no weights
+  uint32_t const_elems = 0;
+  // tensorflow only: number of compute nodes replaced by a call of their own function
+  uint32_t function_num = 0;
+  // tensorflow only: nodes in the body of every function
+  uint32_t function_body_nodes = 8;
+  // channel dim of the model input
+  uint32_t channel = 16;
+  uint32_t seed = 1;
+};
+
+///
+/// @ingroup domi_omg
+/// @brief Write a frozen GraphDef of Placeholder -> {Add with Const | Relu | PartitionedCall} nodes.
+///        When function_num is not 0 the subgraphs are also written to graph_def_library.pbtxt
+///        next to model_file, the way func2graph.py prepares them for the parser.
+/// @param [in] spec model shape
+/// @param [in] model_file path of the .pb to write
+///
+Status GenerateTensorFlowModel(const ModelSpec &spec, const std::string &model_file);
+
+///
+/// @ingroup domi_omg
+/// @brief Write a prototxt of Input -> {InnerProduct | ReLU} layers and the matching caffemodel
+/// @param [in] spec model shape, function_num is ignored
+/// @param [in] model_file path of the .prototxt to write
+/// @param [in] weights_file path of the .caffemodel to write
+///
+Status GenerateCaffeModel(const ModelSpec &spec, const std::string &model_file, const std::string &weights_file);
+
+///
+/// @ingroup domi_omg
+/// @brief Write an onnx model of input -> {Add with initializer | Relu} nodes
+/// @param [in] spec model shape, function_num is ignored
+/// @param [in] model_file path of the .onnx to write
+///
+Status GenerateOnnxModel(const ModelSpec &spec, const std::string &model_file);
+}  // namespace parser
+}  // namespace ge
+
+#endif  // PARSER_BENCHMARK_MODEL_GENERATOR_H_
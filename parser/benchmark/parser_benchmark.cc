@@ -0,0 +1,284 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+// Generates a synthetic model, parses it end to end a few times and reports wall time,
+// per stage time and peak memory as json. One framework per process, so that peak RSS
+// only reflects that framework.
+//
+// parser_benchmark --framework=tensorflow|caffe|onnx [--nodes=10000] [--fan_out=1] [--const_elems=0]
+//                  [--function_num=0] [--function_body_nodes=8] [--repeat=3] [--seed=1]
+//                  [--work_dir=.] [--output=parser_benchmark.json]
+//                  [--api=parse|subgraph] [--incremental=0|1]
+//
+// --api=subgraph parses a tensorflow model with repeated ParseProtoWithSubgraph calls, as online training does.
+// --incremental=1 then sets the GE option incremental_parse, compare its runs with a run of --incremental=0.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/omg/parser/parser_inner_ctx.h"
+#include "graph/ge_local_context.h"
+#include "graph/utils/graph_utils.h"
+#include "omg/parser/parser_factory.h"
+#include "parser/benchmark/model_generator.h"
+#include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/model_saver.h"
+#include "parser/common/parser_profiler.h"
+#include "proto/tensorflow/graph.pb.h"
+
+namespace ge {
+namespace parser {
+namespace {
+struct BenchmarkOptions {
+  std::string framework;
+  ModelSpec spec;
+  uint32_t repeat = 3;
+  uint32_t incremental = 0;
+  std::string api = "parse";
+  std::string work_dir = ".";
+  std::string output = "parser_benchmark.json";
+};
+
+int64_t GetPeakRssKb() {
+  struct rusage usage = {};
+  return (getrusage(RUSAGE_SELF, &usage) == 0) ? static_cast<int64_t>(usage.ru_maxrss) : -1;
+}
+
+bool ParseUint(const std::string &value, uint32_t &result) {
+  char *end = nullptr;
+  unsigned long number = strtoul(value.c_str(), &end, 10);
+  if (value.empty() || (end == nullptr) || (*end != '\0') || (number > UINT32_MAX)) {
+    return false;
+  }
+  result = static_cast<uint32_t>(number);
+  return true;
+}
+
+bool ParseOptions(int argc, char **argv, BenchmarkOptions &options) {
+  std::map<std::string, uint32_t *> uint_options = {
+      {"nodes", &options.spec.node_num},
+      {"fan_out", &options.spec.fan_out},
+      {"const_elems", &options.spec.const_elems},
+      {"function_num", &options.spec.function_num},
+      {"function_body_nodes", &options.spec.function_body_nodes},
+      {"seed", &options.spec.seed},
+      {"repeat", &options.repeat},
+      {"incremental", &options.incremental}};
+  std::map<std::string, std::string *> string_options = {
+      {"framework", &options.framework}, {"api", &options.api}, {"work_dir", &options.work_dir},
+      {"output", &options.output}};
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    size_t pos = arg.find('=');
+    if ((arg.compare(0, 2, "--") != 0) || (pos == std::string::npos)) {
+      std::cerr << "Invalid argument " << arg << ", expect --name=value." << std::endl;
+      return false;
+    }
+    std::string name = arg.substr(2, pos - 2);
+    std::string value = arg.substr(pos + 1);
+    auto uint_iter = uint_options.find(name);
+    auto string_iter = string_options.find(name);
+    if (uint_iter != uint_options.end()) {
+      if (!ParseUint(value, *uint_iter->second)) {
+        std::cerr << "Invalid value " << value << " of --" << name << "." << std::endl;
+        return false;
+      }
+    } else if (string_iter != string_options.end()) {
+      *string_iter->second = value;
+    } else {
+      std::cerr << "Unknown argument --" << name << "." << std::endl;
+      return false;
+    }
+  }
+  if ((options.framework != "tensorflow") && (options.framework != "caffe") && (options.framework != "onnx")) {
+    std::cerr << "--framework must be tensorflow, caffe or onnx." << std::endl;
+    return false;
+  }
+  if ((options.api != "parse") && (options.api != "subgraph")) {
+    std::cerr << "--api must be parse or subgraph." << std::endl;
+    return false;
+  }
+  if ((options.api == "subgraph") && ((options.framework != "tensorflow") || (options.spec.function_num > 0))) {
+    std::cerr << "--api=subgraph only supports tensorflow models without functions." << std::endl;
+    return false;
+  }
+  options.repeat = std::max(options.repeat, 1U);
+  return true;
+}
+
+domi::FrameworkType GetFrameworkType(const std::string &framework) {
+  if (framework == "caffe") {
+    return domi::CAFFE;
+  }
+  return (framework == "onnx") ? domi::ONNX : domi::TENSORFLOW;
+}
+
+Status GenerateModel(const BenchmarkOptions &options, std::string &model_file, std::string &weights_file) {
+  std::string prefix = options.work_dir + "/parser_benchmark_" + options.framework;
+  if (options.framework == "tensorflow") {
+    model_file = prefix + ".pb";
+    return GenerateTensorFlowModel(options.spec, model_file);
+  }
+  if (options.framework == "caffe") {
+    model_file = prefix + ".prototxt";
+    weights_file = prefix + ".caffemodel";
+    return GenerateCaffeModel(options.spec, model_file, weights_file);
+  }
+  model_file = prefix + ".onnx";
+  return GenerateOnnxModel(options.spec, model_file);
+}
+
+Status RunOnce(const BenchmarkOptions &options, const std::string &model_file, const std::string &weights_file,
+               const domi::tensorflow::GraphDef &graph_def, uint32_t index, Json &run) {
+  domi::FrameworkType type = GetFrameworkType(options.framework);
+  GetParserContext().type = type;
+  // Reset the parser context the way the acl entries do before every parse
+  AclGrphParseUtil acl_graph_parse_util;
+  std::map<AscendString, AscendString> parser_params;
+  std::string graph_name;
+  GE_RETURN_IF_ERROR(acl_graph_parse_util.ParseParamsBeforeGraph(parser_params, graph_name));
+
+  std::string trace_file = options.work_dir + "/parser_benchmark_" + options.framework + "_trace_" +
+                           std::to_string(index) + ".json";
+  parser_params.emplace(AscendString(PARSER_PROFILING_FILE), AscendString(trace_file.c_str()));
+  ParserProfiler::Instance().Start(parser_params);
+
+  uint64_t start_us = GetCurrentTimestamp();
+  // Every run parses into a graph of the same name, so incremental parse finds the records of the last run
+  ComputeGraphPtr compute_graph = MakeShared<ComputeGraph>("benchmark");
+  GE_CHECK_NOTNULL(compute_graph);
+  Graph graph = GraphUtils::CreateGraphFromComputeGraph(compute_graph);
+  auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(type);
+  GE_CHECK_NOTNULL(model_parser);
+  Status ret = SUCCESS;
+  if (options.api == "subgraph") {
+    ret = model_parser->ParseProtoWithSubgraph(
+        &graph_def, [](const google::protobuf::Message *, const std::string &) {
+          return std::unique_ptr<google::protobuf::Message>();
+        }, compute_graph);
+  } else {
+    ret = model_parser->Parse(model_file.c_str(), graph);
+  }
+  if ((ret == SUCCESS) && !weights_file.empty()) {
+    auto weights_parser = domi::WeightsParserFactory::Instance()->CreateWeightsParser(type);
+    GE_CHECK_NOTNULL(weights_parser);
+    PARSER_TIMESTAMP_START(ParseWeights);
+    ret = weights_parser->Parse(weights_file.c_str(), graph);
+    PARSER_TIMESTAMP_END(ParseWeights, "WeightsParser::Parse");
+  }
+  uint64_t end_us = GetCurrentTimestamp();
+
+  std::map<std::string, uint64_t> stage_cost = ParserProfiler::Instance().GetStageCost();
+  (void)ParserProfiler::Instance().Finish();
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Parse %s model %s failed.", options.framework.c_str(), model_file.c_str());
+    return ret;
+  }
+
+  run["wall_us"] = end_us - start_us;
+  run["stages_us"] = stage_cost;
+  run["peak_rss_kb"] = GetPeakRssKb();
+  run["graph_nodes"] = compute_graph->GetAllNodesSize();
+  run["trace_file"] = trace_file;
+  return SUCCESS;
+}
+
+int RunBenchmark(const BenchmarkOptions &options) {
+  std::string model_file;
+  std::string weights_file;
+  uint64_t generate_start_us = GetCurrentTimestamp();
+  if (GenerateModel(options, model_file, weights_file) != SUCCESS) {
+    std::cerr << "Generate " << options.framework << " model failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  uint64_t generate_us = GetCurrentTimestamp() - generate_start_us;
+
+  // Load custom op plugins and protos once, as a conversion process does
+  std::map<std::string, std::string> init_options = {
+      {std::string(ge::FRAMEWORK_TYPE), std::to_string(GetFrameworkType(options.framework))}};
+  AclGrphParseUtil acl_graph_parse_util;
+  (void)acl_graph_parse_util.AclParserInitialize(init_options);
+  int64_t baseline_rss_kb = GetPeakRssKb();
+
+  // --api=subgraph hands the GraphDef to the parser, it is read once like the caller of ParseProtoWithSubgraph does
+  domi::tensorflow::GraphDef graph_def;
+  if ((options.api == "subgraph") && !ReadProtoFromBinaryFile(model_file.c_str(), &graph_def)) {
+    std::cerr << "Read " << model_file << " failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::map<std::string, std::string> graph_options = {
+      {INCREMENTAL_PARSE, (options.incremental != 0) ? "true" : "false"}};
+  GetThreadLocalContext().SetGraphOption(graph_options);
+
+  Json runs = Json::array();
+  std::vector<uint64_t> wall_us;
+  for (uint32_t i = 0; i < options.repeat; ++i) {
+    Json run;
+    if (RunOnce(options, model_file, weights_file, graph_def, i, run) != SUCCESS) {
+      std::cerr << "Parse " << model_file << " failed, see the parser log." << std::endl;
+      return EXIT_FAILURE;
+    }
+    wall_us.push_back(run["wall_us"].get<uint64_t>());
+    runs.push_back(run);
+  }
+  std::sort(wall_us.begin(), wall_us.end());
+
+  Json report;
+  report["framework"] = options.framework;
+  report["api"] = options.api;
+  report["incremental"] = (options.incremental != 0);
+  report["model"]["file"] = model_file;
+  report["model"]["weights_file"] = weights_file;
+  report["model"]["nodes"] = options.spec.node_num;
+  report["model"]["fan_out"] = options.spec.fan_out;
+  report["model"]["const_elems"] = options.spec.const_elems;
+  report["model"]["function_num"] = options.spec.function_num;
+  report["model"]["function_body_nodes"] = options.spec.function_body_nodes;
+  report["model"]["seed"] = options.spec.seed;
+  report["model"]["generate_us"] = generate_us;
+  report["baseline_rss_kb"] = baseline_rss_kb;
+  report["runs"] = runs;
+  report["summary"]["min_wall_us"] = wall_us.front();
+  report["summary"]["median_wall_us"] = wall_us[wall_us.size() / 2];
+  report["summary"]["max_wall_us"] = wall_us.back();
+  report["summary"]["peak_rss_kb"] = GetPeakRssKb();
+
+  std::cout << report.dump(2) << std::endl;
+  if (ModelSaver::SaveJsonToFile(options.output.c_str(), report) != SUCCESS) {
+    std::cerr << "Write report " << options.output << " failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}  // namespace
+}  // namespace parser
+}  // namespace ge
+
+int main(int argc, char **argv) {
+  ge::parser::BenchmarkOptions options;
+  if (!ge::parser::ParseOptions(argc, argv, options)) {
+    return EXIT_FAILURE;
+  }
+  return ge::parser::RunBenchmark(options);
+}
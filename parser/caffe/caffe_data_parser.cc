@@ -156,5 +156,5 @@ Status CaffeDataParser::ParseParamsForDummyData(const domi::caffe::LayerParamete
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(CAFFE, DATA, CaffeDataParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(CAFFE, DATA, CaffeDataParser);
 }  // namespace ge
@@ -16,7 +16,10 @@
 
 #include "parser/caffe/caffe_op_parser.h"
 #include <memory>
+#include <vector>
 #include "parser/common/op_parser_factory.h"
+#include "parser/common/parser_fp16_t.h"
+#include "parser/common/weight_precision.h"
 #include "common/util/error_manager/error_manager.h"
 #include "framework/omg/parser/parser_types.h"
 
@@ -81,6 +84,7 @@ Status CaffeOpParser::ParseWeightType(const BlobProto &proto, const ge::GeShape
   // Extract weight data and store it in weightdef by float type
   GE_CHECK_NOTNULL(weight);
   ge::DataType dtype = ge::DT_FLOAT;
+  bool to_fp16 = ge::parser::WeightPrecision::ShouldConvert(lay_name, dtype, size);
   if (proto.double_data_size() > 0) {
     // Convert by double type
     if (size != proto.double_data_size()) {
@@ -92,13 +96,24 @@ Status CaffeOpParser::ParseWeightType(const BlobProto &proto, const ge::GeShape
           proto.double_data_size());
       return FAILED;
     }
-    std::unique_ptr<float[]> buf(new (std::nothrow) float[size]());
-    GE_CHECK_NOTNULL(buf);
-    for (int i = 0; i < size; ++i) {
-      buf[i] = proto.double_data(i);
+    if (to_fp16) {
+      // Straight from double, going through float would round twice
+      std::vector<uint16_t> half(size);
+      ge::parser::DoubleToFp16Array(proto.double_data().data(), half.data(), half.size());
+      GE_IF_BOOL_EXEC(
+        weight->SetData(reinterpret_cast<uint8_t *>(half.data()), size * sizeof(uint16_t)) != ge::GRAPH_SUCCESS,
+        GELOGW("SetData failed for GeTensor."););  // no need to return
+      dtype = ge::DT_FLOAT16;
+    } else {
+      std::unique_ptr<float[]> buf(new (std::nothrow) float[size]());
+      GE_CHECK_NOTNULL(buf);
+      for (int i = 0; i < size; ++i) {
+        buf[i] = proto.double_data(i);
+      }
+      GE_IF_BOOL_EXEC(
+        weight->SetData(reinterpret_cast<uint8_t *>(buf.get()), size * sizeof(float)) != ge::GRAPH_SUCCESS,
+        GELOGW("SetData failed for GeTensor."););  // no need to return
     }
-    GE_IF_BOOL_EXEC(weight->SetData(reinterpret_cast<uint8_t *>(buf.get()), size * sizeof(float)) != ge::GRAPH_SUCCESS,
-                    GELOGW("SetData failed for GeTensor."););  // no need to return
   } else if (proto.int8_data().length() > 0) {
     if (size != static_cast<int>(proto.int8_data().length())) {
       ErrorManager::GetInstance().ATCReportErrMessage(
@@ -166,22 +181,35 @@ Status CaffeOpParser::ParseWeightType(const BlobProto &proto, const ge::GeShape
     }
     const float *data_ptr = proto.data().data();
     GE_CHECK_NOTNULL(data_ptr);
-    GE_IF_BOOL_EXEC(
-      weight->SetData(reinterpret_cast<const uint8_t *>(data_ptr), size * sizeof(float)) != ge::GRAPH_SUCCESS,
-      GELOGW("SetData failed for GeTensor."););  // no need to return
+    if (to_fp16) {
+      std::vector<uint16_t> half;
+      ge::parser::WeightPrecision::ToFp16(data_ptr, size, half);
+      GE_IF_BOOL_EXEC(
+        weight->SetData(reinterpret_cast<uint8_t *>(half.data()), size * sizeof(uint16_t)) != ge::GRAPH_SUCCESS,
+        GELOGW("SetData failed for GeTensor."););  // no need to return
+      dtype = ge::DT_FLOAT16;
+    } else {
+      GE_IF_BOOL_EXEC(
+        weight->SetData(reinterpret_cast<const uint8_t *>(data_ptr), size * sizeof(float)) != ge::GRAPH_SUCCESS,
+        GELOGW("SetData failed for GeTensor."););  // no need to return
+    }
   }
   ge::GeTensorDesc weight_desc = ge::GeTensorDesc();
   weight_desc.Update(shape, ge::FORMAT_NCHW, dtype);
+  if (dtype == ge::DT_FLOAT16) {
+    // The Const made from this weight gets a Cast back to fp32 once the graph is complete
+    ge::parser::WeightPrecision::MarkConverted(weight_desc);
+  }
   weight->SetTensorDesc(weight_desc);
   return SUCCESS;
 }
 
 // Dropout's corresponding op_parser is registered as caffeopparser, optimized in optimization stage.
-REGISTER_OP_PARSER_CREATOR(CAFFE, DROPOUT, CaffeOpParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(CAFFE, DROPOUT, CaffeOpParser);
 
 // A new operator added by framework in OM model is used to
 // collect and arrange all outputs in the order of the original model's output
 // Net output operator does not need special processing in the parse stage,
 // and directly registers in the op_parser file
-REGISTER_OP_PARSER_CREATOR(CAFFE, NETOUTPUT, CaffeOpParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(CAFFE, NETOUTPUT, CaffeOpParser);
 }  // namespace ge
@@ -46,7 +46,12 @@
 #include "parser/caffe/caffe_custom_parser_adapter.h"
 #include "parser/caffe/caffe_op_parser.h"
 #include "parser/common/op_parser_factory.h"
+#include "parser/common/op_types_without_ir.h"
+#include "parser/common/parse_cache.h"
 #include "parser/common/pre_checker.h"
+#include "parser/common/tbe_plugin_loader.h"
+#include "parser/common/thread_pool.h"
+#include "parser/common/weight_precision.h"
 #include "framework/omg/parser/parser_types.h"
 #include "parser/common/model_saver.h"
 #include "parser/common/acl_graph_parser_util.h"
@@ -63,6 +68,7 @@ using ge::OpParser;
 using ge::OpParserFactory;
 using ge::Pb2Json;
 using ge::PreChecker;
+using ge::ThreadPool;
 using std::ifstream;
 
 #define CAFFE_CHECK_NULL_AND_REPROT_ERRORMSG(val, errormsg)                                     \
@@ -119,6 +125,8 @@ graphStatus aclgrphParseCaffe(const char *model_file, const char *weights_file,
 graphStatus aclgrphParseCaffe(const char *model_file, const char *weights_file,
                               const std::map<AscendString, AscendString> &parser_params, ge::Graph &graph) {
   GE_CHECK_NOTNULL(model_file);
+  ge::parser::ParserProfileSession profile_session(parser_params);
+  PARSER_PROFILE_SCOPE("aclgrphParseCaffe");
   GetParserContext().type = domi::CAFFE;
   std::map<string, string> options;
   options.insert(std::pair<string, string>(string(ge::FRAMEWORK_TYPE), to_string(ge::CAFFE)));
@@ -132,35 +140,56 @@ graphStatus aclgrphParseCaffe(const char *model_file, const char *weights_file,
     GELOGE(ge::FAILED, "Parser params before graph failed.");
     return ge::FAILED;
   }
+  ge::parser::ParseOptionsScope parse_options_scope(acl_graph_parse_util.GetParseOptions());
   // Create an empty computegraph
   string graph_name = output_name.empty() ? "tmpGraph" : output_name;
   ge::ComputeGraphPtr compute_graph = ge::parser::MakeShared<ge::ComputeGraph>(graph_name);
   GE_CHECK_NOTNULL(compute_graph);
 
   graph = ge::GraphUtils::CreateGraphFromComputeGraph(compute_graph);
-  auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::CAFFE);
-  GE_CHECK_NOTNULL(model_parser);
 
-  // parse caffe model_file and weights_file to GE graph
-  ge::graphStatus ret = model_parser->Parse(model_file, graph);
-  if (ret != ge::SUCCESS) {
-    GELOGE(ret, "Parser graph %s failed.", graph.GetName().c_str());
+  ge::parser::ParseCache parse_cache;
+  if (parse_cache.Init({model_file, weights_file}, parser_params) != ge::SUCCESS) {
+    GELOGE(ge::FAILED, "Init parse cache of %s failed.", model_file);
     return ge::FAILED;
   }
-  GELOGI("Parser graph %s success.", graph.GetName().c_str());
+  if (!parse_cache.Load(graph)) {
+    auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::CAFFE);
+    GE_CHECK_NOTNULL(model_parser);
 
-  if (acl_graph_parse_util.ParseParamsAfterGraph(graph, parser_params) != ge::SUCCESS) {
-    GELOGE(ge::FAILED, "Parser params after graph failed.");
-    return ge::FAILED;
-  }
+    // parse caffe model_file and weights_file to GE graph
+    PARSER_TIMESTAMP_START(ParseModel);
+    ge::graphStatus ret = model_parser->Parse(model_file, graph);
+    if (ret != ge::SUCCESS) {
+      GELOGE(ret, "Parser graph %s failed.", graph.GetName().c_str());
+      return ge::FAILED;
+    }
+    PARSER_TIMESTAMP_END(ParseModel, "CaffeModelParser::Parse");
+    GELOGI("Parser graph %s success.", graph.GetName().c_str());
 
-  auto weights_parser = domi::WeightsParserFactory::Instance()->CreateWeightsParser(domi::CAFFE);
-  ret = weights_parser->Parse(weights_file, graph);
-  if (ret != ge::SUCCESS) {
-    GELOGE(ret, "Weights parse failed. graph: %s", graph.GetName().c_str());
-    return ret;
+    PARSER_TIMESTAMP_START(ParseParamsAfterGraph);
+    if (acl_graph_parse_util.ParseParamsAfterGraph(graph, parser_params) != ge::SUCCESS) {
+      GELOGE(ge::FAILED, "Parser params after graph failed.");
+      return ge::FAILED;
+    }
+    PARSER_TIMESTAMP_END(ParseParamsAfterGraph, "AclGrphParseUtil::ParseParamsAfterGraph");
+
+    auto weights_parser = domi::WeightsParserFactory::Instance()->CreateWeightsParser(domi::CAFFE);
+    GE_CHECK_NOTNULL(weights_parser);
+    PARSER_TIMESTAMP_START(ParseWeights);
+    ret = weights_parser->Parse(weights_file, graph);
+    if (ret != ge::SUCCESS) {
+      GELOGE(ret, "Weights parse failed. graph: %s", graph.GetName().c_str());
+      return ret;
+    }
+    PARSER_TIMESTAMP_END(ParseWeights, "CaffeWeightsParser::Parse");
+    GELOGI("Weights parse success. graph: %s", graph.GetName().c_str());
+    if (ge::parser::WeightPrecision::InsertCasts(ge::GraphUtils::GetComputeGraph(graph)) != ge::SUCCESS) {
+      GELOGE(ge::FAILED, "Insert casts behind fp16 weights of graph %s failed.", graph.GetName().c_str());
+      return ge::FAILED;
+    }
+    parse_cache.Save(graph);
   }
-  GELOGI("Weights parse success. graph: %s", graph.GetName().c_str());
 
   if (acl_graph_parse_util.SetOutputNodeInfo(graph, parser_params) != ge::SUCCESS) {
     GELOGE(ge::FAILED, "Set graph %s default output node failed.", graph.GetName().c_str());
@@ -178,6 +207,9 @@ const int32_t kAnchorIndexOne = 1;
 const int32_t kAnchorIndexTwo = 2;
 const int32_t kAnchorIndexThree = 3;
 const int32_t kNumOne = 1;
+const uint32_t kThreadNum = 16;
+// Layers built by one task of AddNodes, smaller nets are built without the thread pool
+const size_t kMinLayersPerBuildTask = 64;
 const size_t kTensorNum = 2;
 const int kMaxParseDepth = 5;
 const int32_t kMinLineWorldSize = 3;
@@ -238,6 +270,17 @@ Status CheckPathValid(const char *model_path, const string &custom_proto, string
 
   return SUCCESS;
 }
+
+// Data layer parsers record the input dims in the global parser context, so they are never built in parallel
+bool IsDataLayer(const domi::caffe::LayerParameter &layer) {
+  string op_type = layer.type();
+  auto m_iter = ge::GetParserContext().op_conf_map.find(op_type);
+  if (m_iter != ge::GetParserContext().op_conf_map.end()) {
+    op_type = m_iter->second;
+  }
+  auto iter = caffe_op_map.find(op_type);
+  return (iter != caffe_op_map.end()) && (iter->second == ge::parser::DATA);
+}
 }  // namespace
    /*
       MultiLabelLMDB?The negligible layer for weight analysis in license plate recognition network of Safe city.
@@ -988,8 +1031,8 @@ Status CaffeModelParser::ParseOpParam(const domi::caffe::LayerParameter &layer,
   return SUCCESS;
 }
 
-Status CaffeModelParser::AddNode(const domi::caffe::LayerParameter &layer, ge::ComputeGraphPtr &graph) {
-  GE_CHECK_NOTNULL(graph);
+Status CaffeModelParser::BuildOpDesc(const domi::caffe::LayerParameter &layer, ge::OpDescPtr &op,
+                                     std::shared_ptr<OpParser> &op_parser) {
   // Release in node destructor
   string op_type;
 
@@ -1051,11 +1094,10 @@ Status CaffeModelParser::AddNode(const domi::caffe::LayerParameter &layer, ge::C
   // create OpParser
   std::shared_ptr<OpParserFactory> factory = OpParserFactory::Instance(domi::CAFFE);
   GE_CHECK_NOTNULL(factory);
-  std::shared_ptr<OpParser> op_parser = factory->CreateOpParser(op_type);
+  op_parser = factory->CreateOpParser(op_type);
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(op_parser == nullptr, return FAILED, "op_parser is null, op_type: %s.",
                                  op_type.c_str());
 
-  ge::OpDescPtr op;
   // Process change of tensordesc initialization of opdesc,
   // The previous process tensordesc was constructed according to the graph structure in the builder stage
   // The current process requires tensordesc to determine before the opdesc of the operator is added to the graph
@@ -1085,7 +1127,13 @@ Status CaffeModelParser::AddNode(const domi::caffe::LayerParameter &layer, ge::C
     outputDescPtr->SetFormat(format);
     outputDescPtr->SetOriginFormat(format);
   }
+  return SUCCESS;
+}
 
+Status CaffeModelParser::AddNode(const domi::caffe::LayerParameter &layer, const ge::OpDescPtr &op,
+                                 const std::shared_ptr<OpParser> &op_parser, ge::ComputeGraphPtr &graph) {
+  GE_CHECK_NOTNULL(graph);
+  GE_CHECK_NOTNULL(op);
   ge::NodePtr node = graph->AddNode(op);
   if (node == nullptr) {
     GELOGE(FAILED, "call Graph add node failed, op name:%s, type:%s", op->GetName().c_str(), op->GetType().c_str());
@@ -1109,6 +1157,61 @@ Status CaffeModelParser::AddNode(const domi::caffe::LayerParameter &layer, ge::C
   return SUCCESS;
 }
 
+Status CaffeModelParser::AddNodes(const std::vector<const domi::caffe::LayerParameter *> &layers,
+                                  ge::ComputeGraphPtr &graph, bool &has_error) {
+  GE_CHECK_NOTNULL(graph);
+  std::vector<ge::OpDescPtr> ops(layers.size());
+  std::vector<std::shared_ptr<OpParser>> op_parsers(layers.size());
+  std::vector<Status> build_rets(layers.size(), SUCCESS);
+  std::vector<bool> built(layers.size(), false);
+  for (size_t i = 0; i < layers.size(); ++i) {
+    if (IsDataLayer(*layers[i])) {
+      build_rets[i] = BuildOpDesc(*layers[i], ops[i], op_parsers[i]);
+      built[i] = true;
+    }
+  }
+  // Building the op descs of the other layers and parsing their params only reads the parser state, so it runs
+  // in parallel over ranges of layers. Adding the nodes stays serial and in layer order, which keeps the graph
+  // the same as before.
+  auto build_range = [this, &layers, &ops, &op_parsers, &build_rets, &built](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      if (!built[i]) {
+        build_rets[i] = BuildOpDesc(*layers[i], ops[i], op_parsers[i]);
+      }
+    }
+    return SUCCESS;
+  };
+  size_t task_num = std::min(static_cast<size_t>(kThreadNum),
+                             (layers.size() + kMinLayersPerBuildTask - 1) / kMinLayersPerBuildTask);
+  if (task_num <= 1) {
+    (void)build_range(0, layers.size());
+  } else {
+    ThreadPool executor(static_cast<uint32_t>(task_num));
+    std::vector<std::future<Status>> futures;
+    size_t range_size = (layers.size() + task_num - 1) / task_num;
+    for (size_t begin = 0; begin < layers.size(); begin += range_size) {
+      std::future<Status> f = executor.commit(build_range, begin, std::min(begin + range_size, layers.size()));
+      if (!f.valid()) {
+        GELOGE(FAILED, "Future is invalid");
+        return FAILED;
+      }
+      futures.push_back(std::move(f));
+    }
+    for (auto &f : futures) {
+      (void)f.get();
+    }
+  }
+
+  // Do not exit immediately when there is an error, wait until all errors are collected before exiting
+  for (size_t i = 0; i < layers.size(); ++i) {
+    if ((build_rets[i] != SUCCESS) || (AddNode(*layers[i], ops[i], op_parsers[i], graph) != SUCCESS)) {
+      GELOGE(FAILED, "Caffe parser add node %s fail.", layers[i]->name().c_str());
+      has_error = true;
+    }
+  }
+  return SUCCESS;
+}
+
 Status CaffeModelParser::AddTensorDescToOpDesc(ge::OpDescPtr &op_desc, const domi::caffe::LayerParameter &layer) {
   GE_CHECK_NOTNULL(op_desc);
   // Data node input and output tensordesc added in parserparam
@@ -1158,14 +1261,12 @@ Status CaffeModelParser::AddTensorDescToOpDescByIr(ge::OpDescPtr &op_desc, const
 
   // Get opDesc by ir
   string layer_name = layer.name();
-  ge::Operator op_factory = ge::OperatorFactory::CreateOperator(layer_name, op_type);
-  if (op_factory.GetName() != layer.name()) {
+  op_desc = ge::OpTypesWithoutIr::Instance().CreateOpDesc(layer_name, op_type);
+  if (op_desc == nullptr) {
     ErrorManager::GetInstance().ATCReportErrMessage("E11011", {"opname", "optype"}, {layer_name, op_type});
     GELOGE(FAILED, "IR for op[%s] optype[%s] is not registered.", layer_name.c_str(), op_type.c_str());
     return FAILED;
   } else {
-    op_desc = ge::OpDescUtils::GetOpDescFromOperator(op_factory);
-    GE_CHECK_NOTNULL(op_desc);
     auto valid_input_size = layer.bottom_size();
     auto blob_size = layer.blobs_size();
     GELOGI("After GetOpDescFromOperator op[%s] type[%s] have all input size: %zu, "
@@ -1434,6 +1535,13 @@ Status CaffeModelParser::PreCheck(const domi::caffe::NetParameter &net) {
       return ge::FAILED;
     }
 
+    // Custom op plugins deferred by the plugin manifest are loaded before the type is checked
+    (void)TBEPluginLoader::Instance().LoadPluginOfOpType(layer.type());
+    auto op_conf_iter = ge::GetParserContext().op_conf_map.find(layer.type());
+    if (op_conf_iter != ge::GetParserContext().op_conf_map.end()) {
+      (void)TBEPluginLoader::Instance().LoadPluginOfOpType(op_conf_iter->second);
+    }
+
     GE_RETURN_WITH_LOG_IF_ERROR(PreChecker::Instance().AddOp(&layer, layer.name(), layer.type()),
                                 "Add layer to PreChecker failed, layer name: %s.", layer.name().c_str());
     GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(PreChecker::Instance().CheckName(&layer) != SUCCESS, return FAILED,
@@ -1446,6 +1554,7 @@ Status CaffeModelParser::PreCheck(const domi::caffe::NetParameter &net) {
 }
 
 Status CaffeModelParser::ParseFromMemory(const char *data, uint32_t size, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   bool has_error = false;
 
   GE_CHK_BOOL_RET_STATUS(data != nullptr, FAILED, "model data  is nullptr.");
@@ -1493,6 +1602,9 @@ Status CaffeModelParser::ParseFromMemory(const char *data, uint32_t size, ge::Co
   std::map<std::string, std::vector<std::string>> layer_params_map;
   // same param name set <paramnames,layernames>
   // std::map<std::vector<std::string>, std::vector<std::string>> params_share_map;
+  // Names, blob maps and in-place renaming depend on the layer order and are settled first, the nodes
+  // are then built by AddNodes
+  std::vector<const domi::caffe::LayerParameter *> valid_layers;
   for (int32_t i = 0; i < layer_count; i++) {
     domi::caffe::LayerParameter &layer = const_cast<domi::caffe::LayerParameter &>(proto_message.layer(i));
 
@@ -1516,14 +1628,6 @@ Status CaffeModelParser::ParseFromMemory(const char *data, uint32_t size, ge::Co
     // Insert the new operator name, the number of times of duplicate name is recorded as 1
     layer_name_map.insert(std::make_pair(layer.name(), kNumOne));
 
-    // Do not exit immediately when there is an error, wait until all errors are collected before exiting
-    Status ret = AddNode(layer, graph);
-    if (ret != SUCCESS) {
-      GELOGE(FAILED, "Caffe parser add node fail.");
-      has_error = true;
-      continue;
-    }
-
     // parse ParamSpec
     std::vector<string> v_param_names;
     for (int i = 0; i < layer.param_size(); i++) {
@@ -1536,7 +1640,9 @@ Status CaffeModelParser::ParseFromMemory(const char *data, uint32_t size, ge::Co
 
     GE_RETURN_WITH_LOG_IF_ERROR(AddBlobsToMap(layer, inplace_blob_name_remapping),
                                 "Caffe parser add blobs to map ret fail.");
+    valid_layers.push_back(&layer);
   }
+  GE_RETURN_IF_ERROR(AddNodes(valid_layers, graph, has_error));
   // Find a layer with the same param name and save it to graph
   GE_RETURN_WITH_LOG_IF_ERROR(FindShareParamLayers(layer_params_map),
                               "Caffe parser find share param layers map ret fail.");
@@ -1568,6 +1674,7 @@ Status CaffeModelParser::ParseFromMemory(const char *data, uint32_t size, ge::Co
 }
 
 Status CaffeModelParser::Parse(const char *model_path, ge::Graph &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(model_path);
   ge::ComputeGraphPtr compute_graph = ge::GraphUtils::GetComputeGraph(graph);
   GE_CHECK_NOTNULL(compute_graph);
@@ -1628,6 +1735,7 @@ Status CaffeModelParser::SaveDataLayerTops(const domi::caffe::LayerParameter &la
 }
 
 Status CaffeModelParser::Parse(const char *model_path, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   bool has_error = false;
   GE_CHECK_NOTNULL(model_path);
   GE_CHECK_NOTNULL(graph);
@@ -1702,6 +1810,9 @@ Status CaffeModelParser::Parse(const char *model_path, ge::ComputeGraphPtr &grap
   // <layername,paramnames>
   std::map<std::string, std::vector<std::string>> layer_params_map;
   // same param name set <paramnames,layernames>
+  // Names, blob maps and in-place renaming depend on the layer order and are settled first, the nodes
+  // are then built by AddNodes
+  std::vector<const domi::caffe::LayerParameter *> valid_layers;
   for (int32_t i = 0; i < layer_count; i++) {
     domi::caffe::LayerParameter &layer = const_cast<domi::caffe::LayerParameter &>(proto_message.layer(i));
     SaveOrigionLayerTops(layer);
@@ -1725,14 +1836,6 @@ Status CaffeModelParser::Parse(const char *model_path, ge::ComputeGraphPtr &grap
     // Insert the new operator name, the number of times of duplicate name is recorded as 1
     layer_name_map.insert(std::make_pair(layer.name(), kNumOne));
 
-    // Do not exit immediately when there is an error, wait until all errors are collected before exiting
-    Status ret = AddNode(layer, graph);
-    if (ret != SUCCESS) {
-      GELOGE(FAILED, "Caffe parser add node fail.");
-      has_error = true;
-      continue;
-    }
-
     // parse ParamSpec
     std::vector<string> v_param_names;
     for (int i = 0; i < layer.param_size(); i++) {
@@ -1745,7 +1848,11 @@ Status CaffeModelParser::Parse(const char *model_path, ge::ComputeGraphPtr &grap
 
     GE_RETURN_WITH_LOG_IF_ERROR(AddBlobsToMap(layer, inplace_blob_name_remapping),
                                 "Caffe parser add blobs to map ret fail.");
-    if (SaveDataLayerTops(layer) != SUCCESS) {
+    valid_layers.push_back(&layer);
+  }
+  GE_RETURN_IF_ERROR(AddNodes(valid_layers, graph, has_error));
+  for (const auto *layer : valid_layers) {
+    if ((node_map.count(layer->name()) > 0) && (SaveDataLayerTops(*layer) != SUCCESS)) {
       GELOGE(FAILED, "Caffe parse: save data layer tops failed.");
       return FAILED;
     }
@@ -1806,12 +1913,10 @@ Status CaffeModelParser::ToJson(const char *model_file, const char *json_file) {
   GE_CHK_BOOL_RET_STATUS(model_file != nullptr, FAILED, "model_file is nullptr.");
   GE_CHK_BOOL_RET_STATUS(json_file != nullptr, FAILED, "json_file is nullptr.");
   domi::caffe::NetParameter net;
-  nlohmann::json j;
 
   GE_RETURN_WITH_LOG_IF_FALSE(ReadModelWithoutWarning(model_file, &net) == SUCCESS,
                               "ReadModelWithoutWarning failed, Please Check file:%s.", model_file);
-  Pb2Json::Message2Json(net, set<string>(), j, true);
-  return ModelSaver::SaveJsonToFile(json_file, j);
+  return ModelSaver::SaveMessageToJsonFile(json_file, net, set<string>(), true);
 }
 
 Status CaffeModelParser::ReorderInput(domi::caffe::NetParameter &net) {
@@ -1847,6 +1952,7 @@ Status CaffeModelParser::ReorderInput(domi::caffe::NetParameter &net) {
 }
 
 Status CaffeWeightsParser::ParseFromMemory(const char *data, uint32_t size, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   if (data == nullptr) {
     GELOGE(PARAM_INVALID, "Caffe weights data is nullptr");
     return PARAM_INVALID;
@@ -1874,6 +1980,7 @@ Status CaffeWeightsParser::ParseFromMemory(const char *data, uint32_t size, ge::
 }
 
 Status CaffeWeightsParser::Parse(const char *file, ge::Graph &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(file);
   ge::ComputeGraphPtr compute_graph = ge::GraphUtils::GetComputeGraph(graph);
   GE_CHECK_NOTNULL(compute_graph);
@@ -1889,6 +1996,7 @@ Status CaffeWeightsParser::Parse(const char *file, ge::Graph &graph) {
 }
 
 Status CaffeWeightsParser::Parse(const char *file, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   if (file == nullptr) {
     GELOGE(FAILED, "Caffe weights parse fail, Parameter file invalid");
     return PARAM_INVALID;
@@ -259,15 +259,41 @@ class CaffeModelParser : public domi::ModelParser {
    */
   Status AddBlobsToMap(const domi::caffe::LayerParameter &layer,
                        std::map<std::string, std::string> &inplace_blob_name_remapping);
+  /**
+   * @ingroup domi_omg
+   * @brief Add the nodes of layers to graph. The op descs are built concurrently,
+   *        the nodes are added in layer order.
+   * @param [in] layers valid layers of the net, in net order
+   * @param [in|out] graph graph for saving model information
+   * @param [out] has_error set if a layer fails, the other layers are still added
+   * @return SUCCESS all layers handled
+   * @return FAILED building op descs could not be started
+   */
+  Status AddNodes(const std::vector<const domi::caffe::LayerParameter *> &layers, ge::ComputeGraphPtr &graph,
+                  bool &has_error);
+  /**
+   * @ingroup domi_omg
+   * @brief Build the op desc of a layer and parse its params, only reads the parser state
+   * @param [in] layer layer infromation
+   * @param [out] op op desc of the layer
+   * @param [out] op_parser op parser of the layer
+   * @return SUCCESS build successfully
+   * @return FAILED build failed
+   */
+  Status BuildOpDesc(const domi::caffe::LayerParameter &layer, ge::OpDescPtr &op,
+                     std::shared_ptr<ge::OpParser> &op_parser);
   /**
    * @ingroup domi_omg
    * @brief Add node information to graph
    * @param [in] layer layer infromation
+   * @param [in] op op desc built by BuildOpDesc
+   * @param [in] op_parser op parser of the layer
    * @param [in|out] graph graph for saving model information
    * @return SUCCESS add successfully
    * @return FAILED add failed
    */
-  Status AddNode(const domi::caffe::LayerParameter &layer, ge::ComputeGraphPtr &graph);
+  Status AddNode(const domi::caffe::LayerParameter &layer, const ge::OpDescPtr &op,
+                 const std::shared_ptr<ge::OpParser> &op_parser, ge::ComputeGraphPtr &graph);
   /**
    * @ingroup domi_omg
    * @brief Add edge information to graph
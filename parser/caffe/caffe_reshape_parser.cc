@@ -139,5 +139,5 @@ Status CaffeReshapeParser::AddConstInput(ge::NodePtr &node) {
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(CAFFE, RESHAPE, CaffeReshapeParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(CAFFE, RESHAPE, CaffeReshapeParser);
 }  // namespace ge
@@ -38,6 +38,7 @@
 #include "graph/opsproto_manager.h"
 #include "graph/utils/type_utils.h"
 #include "omg/parser/parser_inner_ctx.h"
+#include "parser/common/op_types_without_ir.h"
 #include "parser/common/register_tbe.h"
 #include "tbe_plugin_loader.h"
 
@@ -78,6 +79,12 @@ const int kWarningThreshold = 536870912 * 2; // 536870912 represent 512M
 const int kOutputTypeNode = 0;
 const int kOutputTypeIndex = 1;
 const int kOutputTypeDataType = 2;
+const std::set<std::string> kParserOnlyOptions = {ge::parser::PARSE_CACHE_DIR, ge::parser::PARSER_PROFILING_FILE,
+                                                  ge::parser::PARSER_TRACE_SAMPLE, ge::parser::WEIGHT_PRECISION,
+                                                  ge::parser::WEIGHT_PRECISION_EXCLUDE_NODES,
+                                                  ge::parser::SHAPE_FOLDING};
+const char *const kWeightPrecisionSupport = "only support fp32, fp16";
+const char *const kShapeFoldingSupport = "only support true, false";
 
 vector<string> SplitInputShape(const std::string &input_shape) {
   vector<string> shape_pair_vec;
@@ -133,6 +140,27 @@ static void GetOpsProtoPath(string &opsproto_path) {
   opsproto_path = (path_base + "ops/op_proto/custom/" + ":") + (path_base + "ops/op_proto/built-in/");
 }
 
+// Node names in compress_weight_conf, separated by ';'
+static domi::Status ReadCompressWeightConf(const string &compress_weight_conf, string &compress_nodes) {
+  std::string real_path = ge::parser::RealPath(compress_weight_conf.c_str());
+  if (real_path.empty()) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
+                                                    {"compress_weight_conf", compress_weight_conf});
+    GELOGE(ge::PARAM_INVALID, "Can not get real path for %s.", compress_weight_conf.c_str());
+    return ge::PARAM_INVALID;
+  }
+  std::ifstream ifs(real_path);
+  if (!ifs.is_open()) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
+                                                    {"compress_weight_conf", compress_weight_conf});
+    GELOGE(ge::FAILED, "Open file %s failed", compress_weight_conf.c_str());
+    return ge::FAILED;
+  }
+  ifs >> compress_nodes;
+  ifs.close();
+  return ge::SUCCESS;
+}
+
 static void GetAclParams(const std::map<ge::AscendString, ge::AscendString> &parser_params, const string &key,
                          string &value) {
   for (auto &ele : parser_params) {
@@ -306,6 +334,12 @@ domi::Status AclGrphParseUtil::LoadOpsProtoLib() {
   return SUCCESS;
 }
 
+std::string AclGrphParseUtil::GetOpsProtoLibPath() {
+  string opsproto_path;
+  GetOpsProtoPath(opsproto_path);
+  return opsproto_path;
+}
+
 void AclGrphParseUtil::SaveCustomCaffeProtoPath() {
   GELOGD("Enter save custom caffe proto path.");
   std::string path_base = GetSoPath();
@@ -342,6 +376,8 @@ domi::Status AclGrphParseUtil::AclParserInitialize(const std::map<std::string, s
 
   // load and save custom op proto for prediction
   (void)LoadOpsProtoLib();
+  // IR of op types may have changed with the op proto libs
+  OpTypesWithoutIr::Instance().Clear();
   SaveCustomCaffeProtoPath();
 
   auto op_registry = domi::OpRegistry::Instance();
@@ -350,12 +386,10 @@ domi::Status AclGrphParseUtil::AclParserInitialize(const std::map<std::string, s
     return FAILED;
   }
 
-  std::vector<OpRegistrationData> registrationDatas = op_registry->registrationDatas;
-  GELOGI("The size of registrationDatas in parser is: %zu", registrationDatas.size());
-  for (OpRegistrationData &reg_data : registrationDatas) {
+  TBEPluginLoader::Instance().FinalizeRegistrations([op_registry](const OpRegistrationData &reg_data) {
     (void)OpRegistrationTbe::Instance()->Finalize(reg_data, false);
-    domi::OpRegistry::Instance()->Register(reg_data);
-  }
+    op_registry->Register(reg_data);
+  });
 
   // set init status
   if (!parser_initialized) {
@@ -667,6 +701,22 @@ void AclGrphParseUtil::AddAttrsForInputNodes(const vector<string> &adjust_fp16_f
   }
 }
 
+NodePtr AclGrphParseUtil::FindNode(const ComputeGraphPtr &graph, const std::string &name) {
+  // ComputeGraph::FindNode scans the nodes for every name, user options may list thousands of them.
+  // The index is rebuilt when the graph changes in between, e.g. when the weights parser adds nodes.
+  if ((graph != indexed_graph_) || (graph->GetDirectNodesSize() != indexed_node_num_)) {
+    node_index_.clear();
+    for (const auto &node : graph->GetDirectNode()) {
+      // The first node of a name wins, as with ComputeGraph::FindNode
+      (void)node_index_.emplace(node->GetName(), node);
+    }
+    indexed_graph_ = graph;
+    indexed_node_num_ = graph->GetDirectNodesSize();
+  }
+  auto iter = node_index_.find(name);
+  return (iter == node_index_.end()) ? nullptr : iter->second;
+}
+
 domi::Status AclGrphParseUtil::ParseAclInputFp16Nodes(const ComputeGraphPtr &graph, const string &input_fp16_nodes,
                                                       const string &is_input_adjust_hw_layout) {
   GE_CHECK_NOTNULL(graph);
@@ -688,7 +738,7 @@ domi::Status AclGrphParseUtil::ParseAclInputFp16Nodes(const ComputeGraphPtr &gra
   GELOGI("The input_fp16_nodes is set %s", input_fp16_nodes.c_str());
   vector<string> input_fp16_nodes_vec = StringUtils::Split(input_fp16_nodes, ';');
   for (uint32_t i = 0; i < input_fp16_nodes_vec.size(); ++i) {
-    ge::NodePtr node = graph->FindNode(input_fp16_nodes_vec[i]);
+    ge::NodePtr node = FindNode(graph, input_fp16_nodes_vec[i]);
     if (node == nullptr) {
       ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
                                                       {"input_fp16_nodes", input_fp16_nodes_vec[i]});
@@ -716,24 +766,11 @@ domi::Status AclGrphParseUtil::ParseAclWeightCompressConf(const ComputeGraphPtr
   if (compress_weight_conf.empty()) {
     return SUCCESS;
   }
-  std::string real_path = ge::parser::RealPath(compress_weight_conf.c_str());
-  if (real_path.empty()) {
-    ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
-                                                    {"compress_weight_conf", compress_weight_conf});
-    GELOGE(PARAM_INVALID, "Can not get real path for %s.", compress_weight_conf.c_str());
-    return PARAM_INVALID;
-  }
-  std::ifstream ifs(real_path);
-  if (!ifs.is_open()) {
-    ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
-                                                    {"compress_weight_conf", compress_weight_conf});
-    GELOGE(FAILED, "Open file %s failed", compress_weight_conf.c_str());
-    return FAILED;
-  }
-
   std::string compress_nodes;
-  ifs >> compress_nodes;
-  ifs.close();
+  domi::Status ret = ReadCompressWeightConf(compress_weight_conf, compress_nodes);
+  if (ret != SUCCESS) {
+    return ret;
+  }
   if (compress_nodes.empty()) {
     GELOGW("Compress weight of nodes info is empty");
     return SUCCESS;
@@ -742,7 +779,7 @@ domi::Status AclGrphParseUtil::ParseAclWeightCompressConf(const ComputeGraphPtr
 
   vector<string> compress_node_vec = StringUtils::Split(compress_nodes, ';');
   for (size_t i = 0; i < compress_node_vec.size(); ++i) {
-    ge::NodePtr node = graph->FindNode(compress_node_vec[i]);
+    ge::NodePtr node = FindNode(graph, compress_node_vec[i]);
     if (node == nullptr) {
       GELOGW("Node %s is not in graph", compress_node_vec[i].c_str());
       continue;
@@ -757,6 +794,74 @@ domi::Status AclGrphParseUtil::ParseAclWeightCompressConf(const ComputeGraphPtr
   return SUCCESS;
 }
 
+domi::Status AclGrphParseUtil::ParseAclWeightPrecision(const string &weight_precision, const string &exclude_nodes,
+                                                       const string &compress_weight_conf) {
+  ge::DataType target = ge::DT_FLOAT;
+  if (weight_precision == "fp16") {
+    target = ge::DT_FLOAT16;
+  } else if (!weight_precision.empty() && (weight_precision != "fp32")) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E10001", {"parameter", "value", "reason"},
+                                                    {WEIGHT_PRECISION, weight_precision, kWeightPrecisionSupport});
+    GELOGE(PARAM_INVALID, "Invalid value for %s[%s], %s.", WEIGHT_PRECISION, weight_precision.c_str(),
+           kWeightPrecisionSupport);
+    return PARAM_INVALID;
+  }
+
+  std::set<string> exclude_set;
+  if (target != ge::DT_FLOAT) {
+    for (auto &node_name : StringUtils::Split(exclude_nodes, ';')) {
+      StringUtils::Trim(node_name);
+      if (!node_name.empty()) {
+        (void)exclude_set.insert(node_name);
+      }
+    }
+    // Weights to be compressed are expected in fp32
+    if (!compress_weight_conf.empty()) {
+      string compress_nodes;
+      domi::Status ret = ReadCompressWeightConf(compress_weight_conf, compress_nodes);
+      if (ret != SUCCESS) {
+        return ret;
+      }
+      for (const auto &node_name : StringUtils::Split(compress_nodes, ';')) {
+        (void)exclude_set.insert(node_name);
+      }
+    }
+  }
+  parse_options_->weight_precision = target;
+  parse_options_->weight_precision_exclude_nodes = exclude_set;
+  if (target != ge::DT_FLOAT) {
+    GELOGI("Weights are stored as fp16 while parsing, %zu nodes excluded.", exclude_set.size());
+  }
+  return SUCCESS;
+}
+
+domi::Status AclGrphParseUtil::ParseAclShapeFolding(const string &shape_folding) {
+  if (!shape_folding.empty() && (shape_folding != "true") && (shape_folding != "false")) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E10001", {"parameter", "value", "reason"},
+                                                    {SHAPE_FOLDING, shape_folding, kShapeFoldingSupport});
+    GELOGE(PARAM_INVALID, "Invalid value for %s[%s], %s.", SHAPE_FOLDING, shape_folding.c_str(),
+           kShapeFoldingSupport);
+    return PARAM_INVALID;
+  }
+  parse_options_->shape_folding = (shape_folding == "true");
+  return SUCCESS;
+}
+
+domi::Status AclGrphParseUtil::CheckAclWeightPrecisionExcludeNodes(const ComputeGraphPtr &graph,
+                                                                   const string &exclude_nodes) {
+  GE_CHECK_NOTNULL(graph);
+  if ((parse_options_->weight_precision == ge::DT_FLOAT) || exclude_nodes.empty()) {
+    return SUCCESS;
+  }
+  for (auto &node_name : StringUtils::Split(exclude_nodes, ';')) {
+    StringUtils::Trim(node_name);
+    if (!node_name.empty() && (FindNode(graph, node_name) == nullptr)) {
+      GELOGW("Node %s in %s is not in graph", node_name.c_str(), WEIGHT_PRECISION_EXCLUDE_NODES);
+    }
+  }
+  return SUCCESS;
+}
+
 domi::Status AclGrphParseUtil::ParseAclOutputType(const std::string &output_type,
                                                   std::map<std::string, vector<std::string>> &output_node_dt_map) {
   if (output_type.find(':') == std::string::npos) {
@@ -864,7 +969,7 @@ domi::Status AclGrphParseUtil::GetDefaultOutInfo(ge::ComputeGraphPtr &compute_gr
   std::vector<std::pair<std::string, int32_t>> default_out_nodes = ge::GetParserContext().default_out_nodes;
   if (ge::GetParserContext().type == domi::CAFFE && !default_out_nodes.empty()) {
     for (uint32_t i = 0; i < default_out_nodes.size(); ++i) {
-      ge::NodePtr out_node = compute_graph->FindNode(default_out_nodes[i].first);
+      ge::NodePtr out_node = FindNode(compute_graph, default_out_nodes[i].first);
       if (out_node == nullptr) {
         ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
                                                         {"out_nodes", default_out_nodes[i].first});
@@ -908,7 +1013,7 @@ domi::Status AclGrphParseUtil::SetOutputNodeInfo(ge::Graph &graph,
 
   // User declared outputs
   for (uint32_t i = 0; i < user_out_nodes.size(); ++i) {
-    ge::NodePtr out_node = compute_graph->FindNode(user_out_nodes[i].first);
+    ge::NodePtr out_node = FindNode(compute_graph, user_out_nodes[i].first);
     if (out_node == nullptr) {
       ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"},
                                                       {"out_nodes", user_out_nodes[i].first});
@@ -995,7 +1100,7 @@ domi::Status AclGrphParseUtil::CheckOptions(const std::map<AscendString, AscendS
 
     string key_str = key_ascend;
     auto it = ge::ir_option::ir_parser_suppported_options.find(key_str);
-    if (it == ge::ir_option::ir_parser_suppported_options.end()) {
+    if (it == ge::ir_option::ir_parser_suppported_options.end() && kParserOnlyOptions.count(key_str) == 0) {
       ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"}, {"parser_params", key_str});
       GELOGE(PARAM_INVALID, "Input options include unsupported option(%s).Please check!", key_ascend);
       return PARAM_INVALID;
@@ -1028,7 +1133,7 @@ domi::Status AclGrphParseUtil::CheckAclInputShapeNode(const ComputeGraphPtr &gra
   }
   for (auto it : ge::GetParserContext().user_input_dims) {
     std::string node_name = it.first;
-    ge::NodePtr node = graph->FindNode(node_name);
+    ge::NodePtr node = FindNode(graph, node_name);
     if (node == nullptr) {
       ErrorManager::GetInstance().ATCReportErrMessage("E10016", {"parameter", "opname"}, {"input_shape", node_name});
       GELOGE(PARAM_INVALID, "Input parameter[input_shape]'s opname[%s] is not exist in model", node_name.c_str());
@@ -1077,7 +1182,8 @@ domi::Status AclGrphParseUtil::ParseParamsBeforeGraph(const std::map<AscendStrin
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(CheckOptions(parser_params) != SUCCESS, return PARAM_INVALID,
                                  "Parse paragrams invalid.");
   // support paragrams: log, input_format, is_dynamic_input, input_shape, out_nodes
-  //                    is_output_adjust_hw_layout, output, op_name_map, enable_scope_fusion_passes
+  //                    is_output_adjust_hw_layout, output, op_name_map, enable_scope_fusion_passes,
+  //                    weight_precision, weight_precision_exclude_nodes
   string log_level;
   GetAclParams(parser_params, ge::ir_option::LOG_LEVEL, log_level);
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ParseAclLogLevel(log_level) != SUCCESS, return PARAM_INVALID,
@@ -1124,12 +1230,28 @@ domi::Status AclGrphParseUtil::ParseParamsBeforeGraph(const std::map<AscendStrin
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ParseAclEnableScope(enable_scope_fusion_passes) != SUCCESS, return PARAM_INVALID,
                                  "Parse enable_scope_fusion_passes failed");
 
+  string weight_precision;
+  GetAclParams(parser_params, WEIGHT_PRECISION, weight_precision);
+  string weight_precision_exclude_nodes;
+  GetAclParams(parser_params, WEIGHT_PRECISION_EXCLUDE_NODES, weight_precision_exclude_nodes);
+  string compress_weight_conf;
+  GetAclParams(parser_params, ge::ir_option::COMPRESS_WEIGHT_CONF, compress_weight_conf);
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
+      ParseAclWeightPrecision(weight_precision, weight_precision_exclude_nodes, compress_weight_conf) != SUCCESS,
+      return PARAM_INVALID, "Parse weight_precision failed");
+
+  string shape_folding;
+  GetAclParams(parser_params, SHAPE_FOLDING, shape_folding);
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ParseAclShapeFolding(shape_folding) != SUCCESS, return PARAM_INVALID,
+                                 "Parse shape_folding failed");
+
   return SUCCESS;
 }
 
 domi::Status AclGrphParseUtil::ParseParamsAfterGraph(ge::Graph &graph,
                                                      const std::map<AscendString, AscendString> &parser_params) {
   // support paragrams: input_fp16_nodes, is_input_adjust_hw_layout, compress_weight_conf,
+  //                    weight_precision_exclude_nodes
   ComputeGraphPtr compute_graph = GraphUtils::GetComputeGraph(graph);
 
   string input_fp16_nodes;
@@ -1149,6 +1271,12 @@ domi::Status AclGrphParseUtil::ParseParamsAfterGraph(ge::Graph &graph,
   GetAclParams(parser_params, ge::ir_option::COMPRESS_WEIGHT_CONF, compress_weight_conf);
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ParseAclWeightCompressConf(compute_graph, compress_weight_conf) != SUCCESS,
                                  return PARAM_INVALID, "Parse compress_weight_conf failed");
+
+  string weight_precision_exclude_nodes;
+  GetAclParams(parser_params, WEIGHT_PRECISION_EXCLUDE_NODES, weight_precision_exclude_nodes);
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
+      CheckAclWeightPrecisionExcludeNodes(compute_graph, weight_precision_exclude_nodes) != SUCCESS,
+      return PARAM_INVALID, "Check weight_precision_exclude_nodes failed");
   string op_conf_str;
   GetAclParams(parser_params, ge::ir_option::OP_NAME_MAP, op_conf_str);
   if (!op_conf_str.empty()) {
@@ -1396,7 +1524,9 @@ FMK_FUNC_HOST_VISIBILITY bool ValidateStr(const std::string &str, const std::str
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY std::string CurrentTimeInStr() {
   std::time_t now = std::time(nullptr);
-  std::tm *ptm = std::localtime(&now);
+  // localtime_r, several subgraphs may name their function defs at the same time
+  std::tm local_time = {};
+  std::tm *ptm = localtime_r(&now, &local_time);
   if (ptm == nullptr) {
     GELOGE(ge::FAILED, "Localtime failed.");
     return "";
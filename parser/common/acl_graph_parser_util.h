@@ -20,6 +20,7 @@
 #include <google/protobuf/text_format.h>
 
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -28,6 +29,8 @@
 #include "framework/omg/parser/parser_types.h"
 #include "graph/ascend_string.h"
 #include "graph/utils/graph_utils.h"
+#include "parser/common/parse_options.h"
+#include "parser/common/parser_profiler.h"
 #include "register/register_error_codes.h"
 
 namespace ge {
@@ -39,6 +42,8 @@ class AclGrphParseUtil {
   AclGrphParseUtil() {}
   virtual ~AclGrphParseUtil() {}
   domi::Status LoadOpsProtoLib();
+  // Directories of the op proto libs, separated by ':'
+  static std::string GetOpsProtoLibPath();
   void SaveCustomCaffeProtoPath();
   domi::Status AclParserInitialize(const std::map<std::string, std::string> &options);
   domi::Status SetOutputNodeInfo(ge::Graph &graph, const std::map<AscendString, AscendString> &parser_params);
@@ -46,9 +51,17 @@ class AclGrphParseUtil {
                                       std::string &graph_name);
   domi::Status ParseParamsAfterGraph(ge::Graph &graph, const std::map<AscendString, AscendString> &parser_params);
   domi::Status ParseOutputInfo(ge::Graph &graph, const std::map<AscendString, AscendString> &parser_params);
+  // Options of this conversion read by ParseParamsBeforeGraph, install them with ParseOptionsScope
+  ge::parser::ParseOptionsPtr GetParseOptions() const { return parse_options_; }
 
  private:
   bool parser_initialized = false;
+  std::shared_ptr<ge::parser::ParseOptions> parse_options_ = std::make_shared<ge::parser::ParseOptions>();
+  // Name index of the direct nodes of the parsed graph, shared by the steps handling user node names
+  ComputeGraphPtr indexed_graph_;
+  size_t indexed_node_num_ = 0;
+  std::unordered_map<std::string, NodePtr> node_index_;
+  NodePtr FindNode(const ComputeGraphPtr &graph, const std::string &name);
   domi::Status CheckOptions(const std::map<AscendString, AscendString> &parser_params);
   domi::Status GetOutputLeaf(NodePtr node, std::vector<std::pair<ge::NodePtr, int32_t>> &output_nodes_info);
   void GetOutputNodesNameAndIndex(std::vector<std::pair<ge::NodePtr, int32_t>> &output_nodes_info,
@@ -68,6 +81,10 @@ class AclGrphParseUtil {
   domi::Status ParseAclInputFp16Nodes(const ComputeGraphPtr &graph, const string &input_fp16_nodes,
                                       const string &is_input_adjust_hw_layout);
   domi::Status ParseAclWeightCompressConf(const ComputeGraphPtr &graph, const string &compress_weight_conf);
+  domi::Status ParseAclWeightPrecision(const std::string &weight_precision, const std::string &exclude_nodes,
+                                       const std::string &compress_weight_conf);
+  domi::Status ParseAclShapeFolding(const std::string &shape_folding);
+  domi::Status CheckAclWeightPrecisionExcludeNodes(const ComputeGraphPtr &graph, const std::string &exclude_nodes);
   domi::Status ParseAclOutputType(const std::string &output_type,
                                   std::map<std::string, vector<std::string>> &output_node_dt_map);
   domi::Status GetDefaultOutInfo(ge::ComputeGraphPtr &compute_graph,
@@ -77,6 +94,18 @@ class AclGrphParseUtil {
 };
 
 namespace parser {
+// Options only understood by the parser, accepted in parser_params besides ge::ir_option::ir_parser_suppported_options
+const char *const PARSE_CACHE_DIR = "parse_cache_dir";
+const char *const PARSER_PROFILING_FILE = "parser_profiling_file";
+const char *const PARSER_TRACE_SAMPLE = "parser_trace_sample";
+const char *const WEIGHT_PRECISION = "weight_precision";
+const char *const WEIGHT_PRECISION_EXCLUDE_NODES = "weight_precision_exclude_nodes";
+const char *const SHAPE_FOLDING = "shape_folding";
+// Initialize option, directory of the manifest that lets custom op plugins be loaded on demand
+const char *const PLUGIN_MANIFEST_DIR = "plugin_manifest_dir";
+// GE graph option read by ParseProtoWithSubgraph, "true" reuses the ops of unchanged nodes across calls
+const char *const INCREMENTAL_PARSE = "incremental_parse";
+
 ///
 /// @ingroup: domi_common
 /// @brief: get length of file
@@ -251,6 +280,8 @@ inline domi::Status CheckInt64Uint32MulOverflow(int64_t a, uint32_t b) {
     uint64_t endUsec_##stage = ge::parser::GetCurrentTimestamp();                     \
     GELOGI("[GEPERFTRACE] The time cost of %s is [%lu] micro second.", (stage_name),  \
             (endUsec_##stage - startUsec_##stage));                                   \
+    ge::parser::ParserProfiler::Instance().AddSpan((stage_name), startUsec_##stage,   \
+                                                   endUsec_##stage);                  \
   } while (0);
 
 #define PARSER_TIMESTAMP_EVENT_END(stage, stage_name)                                 \
@@ -258,6 +289,8 @@ inline domi::Status CheckInt64Uint32MulOverflow(int64_t a, uint32_t b) {
     uint64_t endUsec_##stage = ge::parser::GetCurrentTimestamp();                     \
     GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second.", (stage_name), \
             (endUsec_##stage - startUsec_##stage));                                   \
+    ge::parser::ParserProfiler::Instance().AddSpan((stage_name), startUsec_##stage,   \
+                                                   endUsec_##stage);                  \
   } while (0);
 
 #endif  // ACL_GRAPH_PARSE_UTIL_
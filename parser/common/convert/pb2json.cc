@@ -18,8 +18,12 @@
 // Description: This imply file for protobuf message and json interconversion
 
 #include "common/convert/pb2json.h"
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 #include "securec.h"
 #include "framework/common/fmk_types.h"
 #include "framework/common/debug/ge_log.h"
@@ -30,7 +34,277 @@ using std::string;
 namespace ge {
 namespace {
 const int kSignificantDigits = 10;
+const int kNumberBufferSize = 32;
+// same size as the number buffer of the Json serializer
+const size_t kFloatBufferSize = 64;
+const size_t kStreamFlushSize = 1024 * 1024;
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t Fnv1aHash(uint64_t hash, const void *data, size_t len) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+// Length of the well formed UTF-8 sequence starting at pos, 0 if it is malformed. Overlong forms, surrogates and
+// code points above U+10FFFF are malformed, as in the UTF-8 decoder of Json::dump
+size_t Utf8SequenceLength(const string &value, size_t pos) {
+  uint8_t lead = static_cast<uint8_t>(value[pos]);
+  size_t len = 0;
+  // allowed range of the second byte, the following bytes are always 0x80..0xBF
+  uint8_t second_min = 0x80;
+  uint8_t second_max = 0xBF;
+  if (lead < 0x80) {
+    return 1;
+  } else if (lead >= 0xC2 && lead <= 0xDF) {
+    len = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    len = 3;
+    second_min = (lead == 0xE0) ? 0xA0 : second_min;
+    second_max = (lead == 0xED) ? 0x9F : second_max;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    len = 4;
+    second_min = (lead == 0xF0) ? 0x90 : second_min;
+    second_max = (lead == 0xF4) ? 0x8F : second_max;
+  } else {
+    return 0;
+  }
+  if (pos + len > value.size()) {
+    return 0;
+  }
+  for (size_t i = 1; i < len; ++i) {
+    uint8_t trail = static_cast<uint8_t>(value[pos + i]);
+    uint8_t trail_min = (i == 1) ? second_min : 0x80;
+    uint8_t trail_max = (i == 1) ? second_max : 0xBF;
+    if (trail < trail_min || trail > trail_max) {
+      return 0;
+    }
+  }
+  return len;
+}
+
+// Message2Json leaves the JSON of a message null when it sets no member, see Message2Json for the field rules
+bool HasJsonFields(const ProtobufMsg &message, const set<string> &black_fields) {
+  auto descriptor = message.GetDescriptor();
+  auto reflection = message.GetReflection();
+  if (descriptor == nullptr || reflection == nullptr) {
+    return false;
+  }
+  for (auto i = 0; i < descriptor->field_count(); ++i) {
+    const auto field = descriptor->field(i);
+    if (field == nullptr) {
+      return false;
+    }
+    if (black_fields.find(field->name()) != black_fields.end()) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      if (reflection->FieldSize(message, field) > 0) {
+        return true;
+      }
+      continue;
+    }
+    if (!reflection->HasField(message, field)) {
+      continue;
+    }
+    if (field->type() != ProtobufFieldDescriptor::TYPE_MESSAGE ||
+        reflection->GetMessage(message, field).ByteSize() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Json objects keep their members sorted by name, so fields are written in name order
+std::vector<const ProtobufFieldDescriptor *> FieldsSortedByName(const ProtobufDescriptor *descriptor) {
+  std::vector<const ProtobufFieldDescriptor *> fields;
+  for (auto i = 0; i < descriptor->field_count(); ++i) {
+    const auto field = descriptor->field(i);
+    if (field == nullptr) {
+      break;
+    }
+    fields.push_back(field);
+  }
+  std::sort(fields.begin(), fields.end(),
+            [](const ProtobufFieldDescriptor *lhs, const ProtobufFieldDescriptor *rhs) {
+              return lhs->name() < rhs->name();
+            });
+  return fields;
+}
+}  // namespace
+
+JsonStreamWriter::JsonStreamWriter(Sink sink, uint32_t indent) : sink_(std::move(sink)), indent_(indent) {
+  buffer_.reserve(kStreamFlushSize);
+}
+
+void JsonStreamWriter::Append(const char *data, size_t len) {
+  buffer_.append(data, len);
+  if (buffer_.size() >= kStreamFlushSize) {
+    (void)Flush();
+  }
+}
+
+bool JsonStreamWriter::Flush() {
+  if (good_ && !buffer_.empty()) {
+    good_ = sink_(buffer_.data(), buffer_.size());
+  }
+  buffer_.clear();
+  return good_;
+}
+
+void JsonStreamWriter::NewLine() {
+  buffer_.push_back('\n');
+  buffer_.append(first_member_.size() * indent_, ' ');
+}
+
+void JsonStreamWriter::BeforeValue() {
+  if (pending_key_) {
+    pending_key_ = false;
+    return;
+  }
+  if (first_member_.empty()) {
+    return;
+  }
+  if (!first_member_.back()) {
+    buffer_.push_back(',');
+  }
+  first_member_.back() = false;
+  NewLine();
+}
+
+void JsonStreamWriter::BeginObject() {
+  BeforeValue();
+  buffer_.push_back('{');
+  first_member_.push_back(true);
+}
+
+void JsonStreamWriter::EndObject() {
+  bool empty = first_member_.back();
+  first_member_.pop_back();
+  if (!empty) {
+    NewLine();
+  }
+  Append("}", 1);
+}
+
+void JsonStreamWriter::BeginArray() {
+  BeforeValue();
+  buffer_.push_back('[');
+  first_member_.push_back(true);
+}
+
+void JsonStreamWriter::EndArray() {
+  bool empty = first_member_.back();
+  first_member_.pop_back();
+  if (!empty) {
+    NewLine();
+  }
+  Append("]", 1);
+}
+
+void JsonStreamWriter::Key(const string &key) {
+  BeforeValue();
+  AppendEscaped(key);
+  Append(": ", 2);
+  pending_key_ = true;
+}
+
+void JsonStreamWriter::String(const string &value) {
+  BeforeValue();
+  AppendEscaped(value);
+}
+
+void JsonStreamWriter::Null() {
+  BeforeValue();
+  Append("null", 4);
+}
+
+void JsonStreamWriter::Bool(bool value) {
+  BeforeValue();
+  Append(value ? "true" : "false");
+}
+
+void JsonStreamWriter::Int(int64_t value) {
+  BeforeValue();
+  Append(std::to_string(value));
+}
+
+void JsonStreamWriter::UInt(uint64_t value) {
+  BeforeValue();
+  Append(std::to_string(value));
+}
+
+void JsonStreamWriter::Double(double value) {
+  BeforeValue();
+  if (!std::isfinite(value)) {
+    Append("null", 4);
+    return;
+  }
+  // the number formatter of Json::dump, so that floats are written with the same digits
+  char str[kFloatBufferSize];
+  const char *end = nlohmann::detail::to_chars(str, str + kFloatBufferSize, value);
+  Append(str, static_cast<size_t>(end - str));
+}
+
+// Same escaping as Json::dump with error_handler_t::ignore: malformed UTF-8 bytes are dropped
+void JsonStreamWriter::AppendEscaped(const string &value) {
+  buffer_.push_back('"');
+  for (size_t pos = 0; pos < value.size();) {
+    size_t len = Utf8SequenceLength(value, pos);
+    if (len == 0) {
+      ++pos;
+      continue;
+    }
+    if (buffer_.size() >= kStreamFlushSize) {
+      (void)Flush();
+    }
+    if (len > 1) {
+      buffer_.append(value, pos, len);
+      pos += len;
+      continue;
+    }
+    char c = value[pos++];
+    switch (c) {
+      case '"':
+        buffer_.append("\\\"");
+        break;
+      case '\\':
+        buffer_.append("\\\\");
+        break;
+      case '\b':
+        buffer_.append("\\b");
+        break;
+      case '\f':
+        buffer_.append("\\f");
+        break;
+      case '\n':
+        buffer_.append("\\n");
+        break;
+      case '\r':
+        buffer_.append("\\r");
+        break;
+      case '\t':
+        buffer_.append("\\t");
+        break;
+      default:
+        if (static_cast<uint8_t>(c) < 0x20) {
+          char str[kSignificantDigits];
+          if (sprintf_s(str, kSignificantDigits, "\\u%04x", static_cast<uint32_t>(c)) != -1) {
+            buffer_.append(str);
+          }
+        } else {
+          buffer_.push_back(c);
+        }
+        break;
+    }
+  }
+  Append("\"", 1);
 }
+
 // JSON parses non utf8 character throwing exceptions, so some fields need to be shielded through black fields
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void Pb2Json::Message2Json(const ProtobufMsg &message,
                                                                             const set<string> &black_fields, Json &json,
@@ -236,6 +510,294 @@ void Pb2Json::Enum2Json(const ProtobufEnumValueDescriptor *enum_value_desc, cons
   }
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool Pb2Json::Message2JsonStream(const ProtobufMsg &message,
+                                                                                  const set<string> &black_fields,
+                                                                                  JsonStreamWriter &writer,
+                                                                                  bool enum2str,
+                                                                                  size_t summary_threshold) {
+  MessageFields2Stream(message, black_fields, writer, enum2str, summary_threshold);
+  return writer.Flush();
+}
+
+void Pb2Json::MessageFields2Stream(const ProtobufMsg &message, const set<string> &black_fields,
+                                   JsonStreamWriter &writer, bool enum2str, size_t summary_threshold) {
+  if (!HasJsonFields(message, black_fields)) {
+    writer.Null();
+    return;
+  }
+  auto descriptor = message.GetDescriptor();
+  auto reflection = message.GetReflection();
+
+  writer.BeginObject();
+  for (const auto field : FieldsSortedByName(descriptor)) {
+    // Do not display weight data
+    if (black_fields.find(field->name()) != black_fields.end()) {
+      continue;
+    }
+
+    if (field->is_repeated()) {
+      auto field_size = static_cast<size_t>(reflection->FieldSize(message, field));
+      if (field_size == 0) {
+        continue;
+      }
+      writer.Key(field->name());
+      if (summary_threshold > 0 && field_size > summary_threshold) {
+        RepeatedFieldSummary2Stream(message, field, reflection, writer);
+      } else {
+        RepeatedField2Stream(message, field, reflection, black_fields, writer, enum2str, summary_threshold);
+      }
+      continue;
+    }
+
+    if (!reflection->HasField(message, field)) {
+      continue;
+    }
+
+    OneField2Stream(message, field, reflection, black_fields, writer, enum2str, summary_threshold);
+  }
+  writer.EndObject();
+}
+
+void Pb2Json::OneField2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                              const ProtobufReflection *reflection, const set<string> &black_fields,
+                              JsonStreamWriter &writer, bool enum2str, size_t summary_threshold) {
+  switch (field->type()) {
+    case ProtobufFieldDescriptor::TYPE_MESSAGE: {
+      const ProtobufMsg &tmp_message = reflection->GetMessage(message, field);
+      if (0 != tmp_message.ByteSize()) {
+        writer.Key(field->name());
+        MessageFields2Stream(tmp_message, black_fields, writer, enum2str, summary_threshold);
+      }
+      break;
+    }
+
+    case ProtobufFieldDescriptor::TYPE_BOOL:
+      writer.Key(field->name());
+      writer.Bool(reflection->GetBool(message, field));
+      break;
+
+    case ProtobufFieldDescriptor::TYPE_ENUM: {
+      auto *enum_value_desc = reflection->GetEnum(message, field);
+      if (enum_value_desc != nullptr) {
+        writer.Key(field->name());
+        enum2str ? writer.String(enum_value_desc->name()) : writer.Int(enum_value_desc->number());
+      }
+      break;
+    }
+
+    case ProtobufFieldDescriptor::TYPE_INT32:
+    case ProtobufFieldDescriptor::TYPE_SINT32:
+    case ProtobufFieldDescriptor::TYPE_SFIXED32:
+      writer.Key(field->name());
+      writer.Int(reflection->GetInt32(message, field));
+      break;
+
+    case ProtobufFieldDescriptor::TYPE_UINT32:
+    case ProtobufFieldDescriptor::TYPE_FIXED32:
+      writer.Key(field->name());
+      writer.UInt(reflection->GetUInt32(message, field));
+      break;
+
+    case ProtobufFieldDescriptor::TYPE_INT64:
+    case ProtobufFieldDescriptor::TYPE_SINT64:
+    case ProtobufFieldDescriptor::TYPE_SFIXED64:
+      writer.Key(field->name());
+      writer.Int(reflection->GetInt64(message, field));
+      break;
+
+    case ProtobufFieldDescriptor::TYPE_UINT64:
+    case ProtobufFieldDescriptor::TYPE_FIXED64:
+      writer.Key(field->name());
+      writer.UInt(reflection->GetUInt64(message, field));
+      break;
+
+    case ProtobufFieldDescriptor::TYPE_FLOAT: {
+      // keep the "%g" string form written by Message2Json
+      writer.Key(field->name());
+      char str[kSignificantDigits];
+      if (sprintf_s(str, kSignificantDigits, "%g", reflection->GetFloat(message, field)) != -1) {
+        writer.String(str);
+      } else {
+        writer.Double(reflection->GetFloat(message, field));
+      }
+      break;
+    }
+
+    case ProtobufFieldDescriptor::TYPE_STRING: {
+      string scratch;
+      writer.Key(field->name());
+      writer.String(reflection->GetStringReference(message, field, &scratch));
+      break;
+    }
+
+    case ProtobufFieldDescriptor::TYPE_BYTES: {
+      string scratch;
+      const string &type_bytes = reflection->GetStringReference(message, field, &scratch);
+      writer.Key(field->name());
+      if (summary_threshold > 0 && type_bytes.size() > summary_threshold) {
+        Summary2Stream(type_bytes.size(), Fnv1aHash(kFnvOffsetBasis, type_bytes.data(), type_bytes.size()), writer);
+      } else if (field->name() != "offset") {
+        writer.String(type_bytes);
+      } else {
+        string field_name = field->name();
+        string bytes_copy = type_bytes;
+        writer.String(TypeBytes2String(field_name, bytes_copy));
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void Pb2Json::RepeatedField2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                                   const ProtobufReflection *reflection, const set<string> &black_fields,
+                                   JsonStreamWriter &writer, bool enum2str, size_t summary_threshold) {
+  writer.BeginArray();
+  for (auto i = 0; i < reflection->FieldSize(message, field); ++i) {
+    switch (field->type()) {
+      case ProtobufFieldDescriptor::TYPE_MESSAGE: {
+        const ProtobufMsg &tmp_message = reflection->GetRepeatedMessage(message, field, i);
+        MessageFields2Stream(tmp_message, black_fields, writer, enum2str, summary_threshold);
+        break;
+      }
+
+      case ProtobufFieldDescriptor::TYPE_BOOL:
+        writer.Bool(reflection->GetRepeatedBool(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_ENUM: {
+        auto *enum_value_desc = reflection->GetRepeatedEnum(message, field, i);
+        if (enum_value_desc == nullptr) {
+          writer.Null();
+        } else {
+          enum2str ? writer.String(enum_value_desc->name()) : writer.Int(enum_value_desc->number());
+        }
+        break;
+      }
+
+      case ProtobufFieldDescriptor::TYPE_INT32:
+      case ProtobufFieldDescriptor::TYPE_SINT32:
+      case ProtobufFieldDescriptor::TYPE_SFIXED32:
+        writer.Int(reflection->GetRepeatedInt32(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_UINT32:
+      case ProtobufFieldDescriptor::TYPE_FIXED32:
+        writer.UInt(reflection->GetRepeatedUInt32(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_INT64:
+      case ProtobufFieldDescriptor::TYPE_SINT64:
+      case ProtobufFieldDescriptor::TYPE_SFIXED64:
+        writer.Int(reflection->GetRepeatedInt64(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_UINT64:
+      case ProtobufFieldDescriptor::TYPE_FIXED64:
+        writer.UInt(reflection->GetRepeatedUInt64(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_FLOAT:
+        writer.Double(reflection->GetRepeatedFloat(message, field, i));
+        break;
+
+      case ProtobufFieldDescriptor::TYPE_STRING:
+      case ProtobufFieldDescriptor::TYPE_BYTES: {
+        string scratch;
+        writer.String(reflection->GetRepeatedStringReference(message, field, i, &scratch));
+        break;
+      }
+
+      default:
+        writer.Null();
+        break;
+    }
+  }
+  writer.EndArray();
+}
+
+// Only the element count and a hash of the element values are written, so that the elements are never expanded
+void Pb2Json::RepeatedFieldSummary2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                                          const ProtobufReflection *reflection, JsonStreamWriter &writer) {
+  uint64_t hash = kFnvOffsetBasis;
+  auto field_size = reflection->FieldSize(message, field);
+  for (auto i = 0; i < field_size; ++i) {
+    switch (field->cpp_type()) {
+      case ProtobufFieldDescriptor::CPPTYPE_MESSAGE: {
+        string serialized;
+        (void)reflection->GetRepeatedMessage(message, field, i).SerializeToString(&serialized);
+        hash = Fnv1aHash(hash, serialized.data(), serialized.size());
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_STRING: {
+        string scratch;
+        const string &value = reflection->GetRepeatedStringReference(message, field, i, &scratch);
+        hash = Fnv1aHash(hash, value.data(), value.size());
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_BOOL: {
+        bool value = reflection->GetRepeatedBool(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_ENUM: {
+        int value = reflection->GetRepeatedEnumValue(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_INT32: {
+        int32_t value = reflection->GetRepeatedInt32(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_UINT32: {
+        uint32_t value = reflection->GetRepeatedUInt32(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_INT64: {
+        int64_t value = reflection->GetRepeatedInt64(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_UINT64: {
+        uint64_t value = reflection->GetRepeatedUInt64(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_FLOAT: {
+        float value = reflection->GetRepeatedFloat(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      case ProtobufFieldDescriptor::CPPTYPE_DOUBLE: {
+        double value = reflection->GetRepeatedDouble(message, field, i);
+        hash = Fnv1aHash(hash, &value, sizeof(value));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  Summary2Stream(static_cast<size_t>(field_size), hash, writer);
+}
+
+void Pb2Json::Summary2Stream(size_t size, uint64_t hash, JsonStreamWriter &writer) {
+  char str[kNumberBufferSize];
+  writer.BeginObject();
+  writer.Key("size");
+  writer.UInt(size);
+  writer.Key("hash");
+  if (sprintf_s(str, kNumberBufferSize, "%016llx", static_cast<unsigned long long>(hash)) != -1) {
+    writer.String(str);
+  } else {
+    writer.UInt(hash);
+  }
+  writer.EndObject();
+}
+
 void Pb2Json::RepeatedEnum2Json(const ProtobufEnumValueDescriptor *enum_value_desc, bool enum2str, Json &json) {
   if (enum_value_desc != nullptr) {
     if (enum2str) {
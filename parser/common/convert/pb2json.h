@@ -23,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/message.h"
 #include "nlohmann/json.hpp"
@@ -35,6 +36,53 @@ using ProtobufFieldDescriptor = ::google::protobuf::FieldDescriptor;
 using ProtobufDescriptor = ::google::protobuf::Descriptor;
 using ProtobufEnumValueDescriptor = ::google::protobuf::EnumValueDescriptor;
 
+/**
+* @ingroup domi_omg
+* @brief Incremental JSON emitter, output is buffered and handed to the sink in large chunks
+*/
+class JsonStreamWriter {
+ public:
+  using Sink = std::function<bool(const char *data, size_t len)>;
+
+  explicit JsonStreamWriter(Sink sink, uint32_t indent = 2);
+  ~JsonStreamWriter() = default;
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+  void Key(const std::string &key);
+  void String(const std::string &value);
+  void Null();
+  void Bool(bool value);
+  void Int(int64_t value);
+  void UInt(uint64_t value);
+  void Double(double value);
+
+  /**
+  * @ingroup domi_omg
+  * @brief Write buffered output to the sink
+  * @return false if the sink failed now or at any earlier flush
+  */
+  bool Flush();
+  bool Good() const { return good_; }
+
+ private:
+  void BeforeValue();
+  void NewLine();
+  void Append(const char *data, size_t len);
+  void Append(const std::string &data) { Append(data.data(), data.size()); }
+  void AppendEscaped(const std::string &value);
+
+  Sink sink_;
+  uint32_t indent_;
+  std::string buffer_;
+  // one entry per open object/array, true while it has no member yet
+  std::vector<bool> first_member_;
+  bool pending_key_ = false;
+  bool good_ = true;
+};
+
 class Pb2Json {
  public:
   /**
@@ -47,6 +95,18 @@ class Pb2Json {
   static void Message2Json(const ProtobufMsg &message, const std::set<std::string> &black_fields, Json &json,
                            bool enum2str = false);
 
+  /**
+  * @ingroup domi_omg
+  * @brief Transfer protobuf object to JSON text without building a JSON object. The text is the same as
+  *        Json::dump with error_handler_t::ignore writes for the Message2Json object, unless fields are summarised
+  * @param [in] writer output stream
+  * @param [in] summary_threshold repeated fields with more elements and bytes fields with more bytes are
+  *             written as {"size", "hash"}, 0 means never summarise
+  * @return true success
+  */
+  static bool Message2JsonStream(const ProtobufMsg &message, const std::set<std::string> &black_fields,
+                                 JsonStreamWriter &writer, bool enum2str = false, size_t summary_threshold = 0);
+
  protected:
   static void RepeatedMessage2Json(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
                                    const ProtobufReflection *reflection, const std::set<std::string> &black_fields,
@@ -62,6 +122,22 @@ class Pb2Json {
                             bool enum2str);
 
   static std::string TypeBytes2String(std::string &field_name, std::string &type_bytes);
+
+  static void MessageFields2Stream(const ProtobufMsg &message, const std::set<std::string> &black_fields,
+                                   JsonStreamWriter &writer, bool enum2str, size_t summary_threshold);
+
+  static void OneField2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                              const ProtobufReflection *reflection, const std::set<std::string> &black_fields,
+                              JsonStreamWriter &writer, bool enum2str, size_t summary_threshold);
+
+  static void RepeatedField2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                                   const ProtobufReflection *reflection, const std::set<std::string> &black_fields,
+                                   JsonStreamWriter &writer, bool enum2str, size_t summary_threshold);
+
+  static void RepeatedFieldSummary2Stream(const ProtobufMsg &message, const ProtobufFieldDescriptor *field,
+                                          const ProtobufReflection *reflection, JsonStreamWriter &writer);
+
+  static void Summary2Stream(size_t size, uint64_t hash, JsonStreamWriter &writer);
 };
 }  // namespace ge
 
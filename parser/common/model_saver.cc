@@ -16,8 +16,10 @@
 
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <cstdlib>
 
 #include "parser/common/model_saver.h"
+#include "parser/common/convert/pb2json.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "common/util/error_manager/error_manager.h"
@@ -25,6 +27,22 @@
 
 namespace {
 const int kFileOpSuccess = 0;
+const char *const kJsonSummaryThresholdEnv = "PARSER_JSON_SUMMARY_THRESHOLD";
+
+size_t GetJsonSummaryThreshold() {
+  const char *threshold_env = std::getenv(kJsonSummaryThresholdEnv);
+  if (threshold_env == nullptr) {
+    return 0;
+  }
+  char *end = nullptr;
+  unsigned long long threshold = std::strtoull(threshold_env, &end, 10);
+  if (end == threshold_env || *end != '\0') {
+    GELOGW("Value[%s] of env %s is not a number, large fields will not be summarised.", threshold_env,
+           kJsonSummaryThresholdEnv);
+    return 0;
+  }
+  return static_cast<size_t>(threshold);
+}
 }  //  namespace
 
 namespace ge {
@@ -51,20 +69,8 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelSaver::SaveJsonToFi
     return FAILED;
   }
 
-  char real_path[PATH_MAX] = {0};
-  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(strlen(file_path) >= PATH_MAX, return FAILED, "file path is too long!");
-  if (realpath(file_path, real_path) == nullptr) {
-    GELOGI("File %s does not exit, it will be created.", file_path);
-  }
-
-  // Open file
-  mode_t mode = S_IRUSR | S_IWUSR;
-  int32_t fd = mmOpen2(real_path, O_RDWR | O_CREAT | O_TRUNC, mode);
-  if (fd == EN_ERROR || fd == EN_INVALID_PARAM) {
-    ErrorManager::GetInstance().ATCReportErrMessage("E19001", {"file", "errmsg"}, {file_path, strerror(errno)});
-    GELOGE(FAILED, "Open file[%s] failed. %s", file_path, strerror(errno));
-    return FAILED;
-  }
+  int32_t fd = EN_ERROR;
+  GE_CHK_STATUS_RET(OpenFile(file_path, fd), "Open file[%s] failed.", file_path);
   const char *model_char = model_str.c_str();
   uint32_t len = static_cast<uint32_t>(model_str.length());
   // Write data to file
@@ -84,6 +90,60 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelSaver::SaveJsonToFi
   return ret;
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelSaver::SaveMessageToJsonFile(
+    const char *file_path, const ProtobufMsg &message, const std::set<string> &black_fields, bool enum2str) {
+  if (file_path == nullptr || SUCCESS != CheckPath(file_path)) {
+    GELOGE(FAILED, "Check output file failed.");
+    return FAILED;
+  }
+  int32_t fd = EN_ERROR;
+  GE_CHK_STATUS_RET(OpenFile(file_path, fd), "Open file[%s] failed.", file_path);
+
+  // The JSON text is written chunk by chunk, no JSON object of the whole model is built in memory
+  JsonStreamWriter writer([fd](const char *data, size_t len) -> bool {
+    while (len > 0) {
+      mmSsize_t write_len = mmWrite(fd, const_cast<char *>(data), static_cast<uint32_t>(len));
+      if (write_len == EN_ERROR || write_len == EN_INVALID_PARAM || write_len <= 0) {
+        return false;
+      }
+      data += write_len;
+      len -= static_cast<size_t>(write_len);
+    }
+    return true;
+  }, kInteval);
+
+  Status ret = SUCCESS;
+  size_t summary_threshold = GetJsonSummaryThreshold();
+  if (!Pb2Json::Message2JsonStream(message, black_fields, writer, enum2str, summary_threshold)) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E19004", {"file", "errmsg"}, {file_path, strerror(errno)});
+    GELOGE(FAILED, "Write to file failed. %s", strerror(errno));
+    ret = FAILED;
+  }
+  if (mmClose(fd) != EN_OK) {
+    GELOGE(FAILED, "Close file failed.");
+    ret = FAILED;
+  }
+  return ret;
+}
+
+Status ModelSaver::OpenFile(const char *file_path, int32_t &fd) {
+  char real_path[PATH_MAX] = {0};
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(strlen(file_path) >= PATH_MAX, return FAILED, "file path is too long!");
+  if (realpath(file_path, real_path) == nullptr) {
+    GELOGI("File %s does not exit, it will be created.", file_path);
+  }
+
+  // Open file
+  mode_t mode = S_IRUSR | S_IWUSR;
+  fd = mmOpen2(real_path, O_RDWR | O_CREAT | O_TRUNC, mode);
+  if (fd == EN_ERROR || fd == EN_INVALID_PARAM) {
+    ErrorManager::GetInstance().ATCReportErrMessage("E19001", {"file", "errmsg"}, {file_path, strerror(errno)});
+    GELOGE(FAILED, "Open file[%s] failed. %s", file_path, strerror(errno));
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelSaver::CheckPath(const std::string &file_path) {
   // Determine file path length
   if (file_path.size() >= PATH_MAX) {
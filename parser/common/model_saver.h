@@ -17,9 +17,11 @@
 #ifndef PARSER_COMMON_FILE_SAVER_H_
 #define PARSER_COMMON_FILE_SAVER_H_
 
+#include <set>
 #include <string>
 
 #include "ge/ge_api_error_codes.h"
+#include "google/protobuf/message.h"
 #include "register/register_types.h"
 #include "nlohmann/json.hpp"
 
@@ -39,6 +41,20 @@ public:
    */
   static Status SaveJsonToFile(const char *file_path, const Json &model);
 
+  /**
+   * @ingroup domi_common
+   * @brief Write protobuf message to file as JSON text without building a JSON object,
+   *        env PARSER_JSON_SUMMARY_THRESHOLD sets the size above which repeated and bytes
+   *        fields are written as length and hash
+   * @param [in] file_path File output path
+   * @param [in] message protobuf message
+   * @param [in] black_fields fields not to write
+   * @param [in] enum2str write enum values by name
+   * @return Status result
+   */
+  static Status SaveMessageToJsonFile(const char *file_path, const google::protobuf::Message &message,
+                                      const std::set<string> &black_fields, bool enum2str);
+
 private:
   ///
   /// @ingroup domi_common
@@ -48,6 +64,8 @@ private:
   static Status CheckPath(const string &file_path);
 
   static int CreateDirectory(const std::string &directory_path);
+
+  static Status OpenFile(const char *file_path, int32_t &fd);
 };
 }  // namespace parser
 }  // namespace ge
@@ -22,6 +22,12 @@ COMMON_LOCAL_SRC_FILES := \
     acl_graph_parser_util.cc \
     tbe_plugin_loader.cc \
     model_saver.cc \
+    parse_cache.cc \
+    parser_profiler.cc \
+    parser_log.cc \
+    op_types_without_ir.cc \
+    parse_options.cc \
+    weight_precision.cc \
     ../tensorflow/tensorflow_custom_parser_adapter.cc \
     ../tensorflow/tensorflow_fusion_custom_parser_adapter.cc \
     ../tensorflow/tensorflow_fusion_op_parser.cc \
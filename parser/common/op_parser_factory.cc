@@ -66,7 +66,11 @@ FMK_FUNC_HOST_VISIBILITY std::shared_ptr<OpParserFactory> OpParserFactory::Insta
 }
 
 FMK_FUNC_HOST_VISIBILITY std::shared_ptr<OpParser> OpParserFactory::CreateOpParser(const std::string &op_type) {
-  // First look for CREATOR_FUN based on OpType, then call CREATOR_FUN to create OpParser.
+  // Stateless OpParsers are shared, the others are created by CREATOR_FUN for each node.
+  auto stateless_iter = stateless_op_parser_map_.find(op_type);
+  if (stateless_iter != stateless_op_parser_map_.end()) {
+    return stateless_iter->second;
+  }
   auto iter = op_parser_creator_map_.find(op_type);
   if (iter != op_parser_creator_map_.end()) {
     return iter->second();
@@ -77,7 +81,11 @@ FMK_FUNC_HOST_VISIBILITY std::shared_ptr<OpParser> OpParserFactory::CreateOpPars
 }
 
 FMK_FUNC_HOST_VISIBILITY std::shared_ptr<OpParser> OpParserFactory::CreateFusionOpParser(const std::string &op_type) {
-  // First look for CREATOR_FUN based on OpType, then call CREATOR_FUN to create OpParser.
+  // Stateless OpParsers are shared, the others are created by CREATOR_FUN for each node.
+  auto stateless_iter = stateless_fusion_op_parser_map_.find(op_type);
+  if (stateless_iter != stateless_fusion_op_parser_map_.end()) {
+    return stateless_iter->second;
+  }
   auto iter = fusion_op_parser_creator_map_.find(op_type);
   if (iter != fusion_op_parser_creator_map_.end()) {
     return iter->second();
@@ -87,17 +95,29 @@ FMK_FUNC_HOST_VISIBILITY std::shared_ptr<OpParser> OpParserFactory::CreateFusion
   return nullptr;
 }
 
-// This function is only called within the constructor of the global opparserregisterar object,
-// and does not involve concurrency, so there is no need to lock it
+// This function is only called within the constructor of the global opparserregisterar object. Plugins deferred
+// by the plugin manifest construct theirs while models are parsed, TBEPluginLoader loads them with its registry
+// lock held exclusively while every parse holds a PluginRegistryReadScope, so the maps are not locked here.
 FMK_FUNC_HOST_VISIBILITY void OpParserFactory::RegisterCreator(const std::string &type, CREATOR_FUN fun,
-                                                               bool is_fusion_op) {
+                                                               bool is_fusion_op, bool is_stateless) {
   std::map<std::string, CREATOR_FUN> *op_parser_creator_map = &op_parser_creator_map_;
+  std::map<std::string, std::shared_ptr<OpParser>> *stateless_op_parser_map = &stateless_op_parser_map_;
   if (is_fusion_op) {
     op_parser_creator_map = &fusion_op_parser_creator_map_;
+    stateless_op_parser_map = &stateless_fusion_op_parser_map_;
   }
 
-  GELOGD("OpParserFactory::RegisterCreator: op type:%s, is_fusion_op:%d.", type.c_str(), is_fusion_op);
+  GELOGD("OpParserFactory::RegisterCreator: op type:%s, is_fusion_op:%d, is_stateless:%d.", type.c_str(),
+         is_fusion_op, is_stateless);
   (*op_parser_creator_map)[type] = fun;
+  // A later registration replaces the earlier one, stateless or not
+  (void)stateless_op_parser_map->erase(type);
+  if (is_stateless && (fun != nullptr)) {
+    std::shared_ptr<OpParser> op_parser = fun();
+    if (op_parser != nullptr) {
+      (*stateless_op_parser_map)[type] = op_parser;
+    }
+  }
 }
 
 FMK_FUNC_HOST_VISIBILITY bool OpParserFactory::OpParserIsRegistered(const std::string &op_type, bool is_fusion_op) {
@@ -50,7 +50,7 @@ class OpParserFactory {
 
   /**
    * @ingroup domi_omg
-   * @brief Create OpParser based on input type
+   * @brief Create OpParser based on input type, stateless OpParsers are shared by all nodes
    * @param [in] op_type Op type
    * @return Created OpParser
    */
@@ -93,8 +93,11 @@ class OpParserFactory {
    * @brief Register creation function
    * @param [in] type Op type
    * @param [in] fun OpParser creation function
+   * @param [in] is_stateless the OpParser keeps no state between nodes, fun is called once and the
+   *             instance is shared by all nodes and threads
    */
-  void RegisterCreator(const std::string &type, CREATOR_FUN fun, bool is_fusion_op = false);
+  void RegisterCreator(const std::string &type, CREATOR_FUN fun, bool is_fusion_op = false,
+                       bool is_stateless = false);
 
  private:
   /**
@@ -103,6 +106,9 @@ class OpParserFactory {
    */
   std::map<std::string, CREATOR_FUN> op_parser_creator_map_;  // lint !e1073
   std::map<std::string, CREATOR_FUN> fusion_op_parser_creator_map_;
+  // Instances of the stateless OpParsers, created at registration
+  std::map<std::string, std::shared_ptr<OpParser>> stateless_op_parser_map_;
+  std::map<std::string, std::shared_ptr<OpParser>> stateless_fusion_op_parser_map_;
 
   friend class OpParserRegisterar;
   friend class domi::OpRegistrationData;
@@ -122,10 +128,12 @@ class OpParserRegisterar {
    * @param [in] framework    Framework type
    * @param [in] op_type      Op type
    * @param [in] fun          Creator function corresponding to Op
+   * @param [in] is_fusion_op  Whether the OpParser parses fusion ops
+   * @param [in] is_stateless  Whether one OpParser instance can parse all nodes
    */
   OpParserRegisterar(const domi::FrameworkType framework, const std::string &op_type, OpParserFactory::CREATOR_FUN fun,
-                     bool is_fusion_op = false) {
-    OpParserFactory::Instance(framework)->RegisterCreator(op_type, fun, is_fusion_op);
+                     bool is_fusion_op = false, bool is_stateless = false) {
+    OpParserFactory::Instance(framework)->RegisterCreator(op_type, fun, is_fusion_op, is_stateless);
   }
   ~OpParserRegisterar() {}
 };
@@ -171,6 +179,25 @@ class CustomParserAdapterRegistrar {
   ge::OpParserRegisterar g_##framework##_##op_type##_Op_Parser_Creator(framework, op_type, \
                                                                        Creator_##framework##_##op_type##_Op_Parser)
 
+/**
+ * @ingroup domi_omg
+ * @brief Registration Macro of an OpParser class that keeps no state between nodes,
+ *        one instance of it is shared by all nodes and parse threads
+ * @param [in] framework    Framework type
+ * @param [in] op_type      Op type
+ * @param [in] clazz        OpParser implementation class
+ */
+#define REGISTER_STATELESS_OP_PARSER_CREATOR(framework, op_type, clazz)                    \
+  std::shared_ptr<OpParser> Creator_##framework##_##op_type##_Op_Parser() {                \
+    std::shared_ptr<clazz> ptr = ge::parser::MakeShared<clazz>();                          \
+    if (ptr == nullptr) {                                                                  \
+      GELOGW("MakeShared failed, result is nullptr.");                                     \
+    }                                                                                      \
+    return std::shared_ptr<OpParser>(ptr);                                                 \
+  }                                                                                        \
+  ge::OpParserRegisterar g_##framework##_##op_type##_Op_Parser_Creator(                    \
+      framework, op_type, Creator_##framework##_##op_type##_Op_Parser, false, true)
+
 #define REGISTER_FUSION_OP_PARSER_CREATOR(framework, op_type, clazz)               \
   std::shared_ptr<OpParser> Creator_##framework##_##op_type##_Fusion_Op_Parser() { \
     std::shared_ptr<clazz> ptr = ge::parser::MakeShared<clazz>();                          \
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parser/common/op_types_without_ir.h"
+#include <unordered_set>
+#include "framework/common/debug/ge_log.h"
+#include "external/graph/operator_factory.h"
+#include "graph/utils/op_desc_utils.h"
+
+namespace ge {
+namespace {
+struct ThreadOpTypes {
+  uint64_t generation = 0;
+  std::unordered_set<std::string> types;
+};
+}  // namespace
+
+OpTypesWithoutIr &OpTypesWithoutIr::Instance() {
+  static OpTypesWithoutIr instance;
+  return instance;
+}
+
+ge::OpDescPtr OpTypesWithoutIr::CreateOpDesc(const std::string &node_name, const std::string &op_type) {
+  thread_local ThreadOpTypes types_without_ir;
+  uint64_t generation = GetGeneration();
+  if (types_without_ir.generation != generation) {
+    types_without_ir.types.clear();
+    types_without_ir.generation = generation;
+  }
+  if (types_without_ir.types.count(op_type) > 0) {
+    return nullptr;
+  }
+
+  ge::Operator op_factory = ge::OperatorFactory::CreateOperator(node_name, op_type);
+  if (op_factory.GetName() != node_name) {
+    op_factory.BreakConnect();
+    GELOGD("No IR registered for op type %s.", op_type.c_str());
+    (void)types_without_ir.types.insert(op_type);
+    return nullptr;
+  }
+  ge::OpDescPtr op_desc = ge::OpDescUtils::GetOpDescFromOperator(op_factory);
+  op_factory.BreakConnect();
+  return op_desc;
+}
+}  // namespace ge
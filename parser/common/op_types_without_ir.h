@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_COMMON_OP_TYPES_WITHOUT_IR_H_
+#define PARSER_COMMON_OP_TYPES_WITHOUT_IR_H_
+
+#include <atomic>
+#include <string>
+#include "graph/op_desc.h"
+
+namespace ge {
+/**
+ * @ingroup domi_omg
+ * @brief Creates node OpDescs from the IR and remembers the op types without IR, so that the failed factory
+ *        lookup of such types is not repeated for every node. Every thread remembers the types it has seen,
+ *        so that lookups take no lock.
+ */
+class OpTypesWithoutIr {
+ public:
+  static OpTypesWithoutIr &Instance();
+
+  /**
+   * @ingroup domi_omg
+   * @brief Create the OpDesc of a node from the IR of op_type
+   * @param [in] node_name name of the node
+   * @param [in] op_type op type registered by IR
+   * @return nullptr if no IR is registered for op_type
+   */
+  ge::OpDescPtr CreateOpDesc(const std::string &node_name, const std::string &op_type);
+
+  /**
+   * @ingroup domi_omg
+   * @brief Forget the op types without IR, called when op proto libs are (re)loaded
+   */
+  void Clear() { generation_.fetch_add(1, std::memory_order_acq_rel); }
+
+  // Bumped by every Clear, lets caches derived from the IR notice a reload
+  uint64_t GetGeneration() const { return generation_.load(std::memory_order_acquire); }
+
+ private:
+  OpTypesWithoutIr() = default;
+  ~OpTypesWithoutIr() = default;
+
+  std::atomic<uint64_t> generation_{0};
+};
+}  // namespace ge
+
+#endif  // PARSER_COMMON_OP_TYPES_WITHOUT_IR_H_
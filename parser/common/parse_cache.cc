@@ -0,0 +1,353 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/common/parse_cache.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "common/util.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/omg/parser/parser_inner_ctx.h"
+#include "graph/buffer.h"
+#include "graph/model.h"
+#include "graph/utils/attr_utils.h"
+#include "framework/common/string_util.h"
+#include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/model_saver.h"
+#include "parser/common/tbe_plugin_loader.h"
+
+namespace ge {
+namespace parser {
+namespace {
+// Bump when the content of a cache entry changes, so that stale entries are never restored
+const char *const kParseCacheVersion = "2";
+const char *const kParseCacheSuffix = ".gecache";
+const char *const kAttrCacheFingerprint = "_parse_cache_fingerprint";
+const char *const kAttrCacheFormat = "_parse_cache_format";
+const char *const kAttrCacheUserOutNodes = "_parse_cache_user_out_nodes";
+const char *const kAttrCacheDefaultOutNodes = "_parse_cache_default_out_nodes";
+const char *const kAttrCacheOutTopNames = "_parse_cache_out_top_names";
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+const size_t kReadChunkSize = 1024 * 1024;
+
+void Fnv1aUpdate(const char *data, size_t len, uint64_t &hash) {
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= kFnvPrime;
+  }
+}
+
+std::string ToHex(uint64_t value) {
+  char buf[sizeof(uint64_t) * 2 + 1] = {0};
+  (void)snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+  return std::string(buf);
+}
+
+bool HashFile(const char *file, uint64_t &hash, int64_t &size) {
+  std::string real_path = RealPath(file);
+  if (real_path.empty()) {
+    GELOGE(FAILED, "File path %s is not valid.", file);
+    return false;
+  }
+  std::ifstream fs(real_path, std::ifstream::in | std::ifstream::binary);
+  if (!fs.is_open()) {
+    GELOGE(FAILED, "Open file %s failed.", real_path.c_str());
+    return false;
+  }
+  std::vector<char> chunk(kReadChunkSize);
+  hash = kFnvOffsetBasis;
+  size = 0;
+  while (fs) {
+    fs.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    std::streamsize read_len = fs.gcount();
+    if (read_len <= 0) {
+      break;
+    }
+    Fnv1aUpdate(chunk.data(), static_cast<size_t>(read_len), hash);
+    size += read_len;
+  }
+  return !fs.bad();
+}
+
+// Size and modification time in ns, "-" for a missing file
+std::string FileStamp(const std::string &file) {
+  struct stat stat_buf;
+  if (stat(file.c_str(), &stat_buf) != 0) {
+    return "-";
+  }
+  int64_t mtime = static_cast<int64_t>(stat_buf.st_mtim.tv_sec) * 1000000000 + stat_buf.st_mtim.tv_nsec;
+  return std::to_string(static_cast<int64_t>(stat_buf.st_size)) + "@" + std::to_string(mtime);
+}
+
+// Shared libraries below dir, in a stable order
+void CollectLibraries(const std::string &dir, std::vector<std::string> &files) {
+  DIR *handle = opendir(dir.c_str());
+  if (handle == nullptr) {
+    return;
+  }
+  std::vector<std::string> names;
+  struct dirent *dent = nullptr;
+  while ((dent = readdir(handle)) != nullptr) {
+    std::string name = dent->d_name;
+    if ((name != ".") && (name != "..")) {
+      names.emplace_back(name);
+    }
+  }
+  closedir(handle);
+  std::sort(names.begin(), names.end());
+
+  const std::string so_suffix = ".so";
+  for (const auto &name : names) {
+    std::string full_name = dir + "/" + name;
+    struct stat stat_buf;
+    if (stat(full_name.c_str(), &stat_buf) != 0) {
+      continue;
+    }
+    if (S_ISDIR(stat_buf.st_mode)) {
+      CollectLibraries(full_name, files);
+    } else if ((name.size() >= so_suffix.size()) &&
+               (name.compare(name.size() - so_suffix.size(), so_suffix.size(), so_suffix) == 0)) {
+      files.emplace_back(full_name);
+    }
+  }
+}
+
+// Path, size and mtime of the library holding this parser, so that a parser upgrade invalidates old results even
+// without a bump of kParseCacheVersion. The library can not change while loaded, it is stamped once.
+const std::string &ParserLibraryStamp() {
+  static const std::string stamp = []() -> std::string {
+    Dl_info dl_info;
+    if ((dladdr(reinterpret_cast<void *>(&GetLibrariesStamp), &dl_info) == 0) || (dl_info.dli_fname == nullptr)) {
+      GELOGW("Failed to read the path of the parser library, parse results are not keyed on it.");
+      return "-";
+    }
+    return std::string(dl_info.dli_fname) + "=" + FileStamp(dl_info.dli_fname);
+  }();
+  return stamp;
+}
+}  // namespace
+
+std::string GetLibrariesStamp() {
+  std::vector<std::string> files = TBEPluginLoader::Instance().GetPluginFiles();
+  std::sort(files.begin(), files.end());
+  for (const auto &dir : StringUtils::Split(AclGrphParseUtil::GetOpsProtoLibPath(), ':')) {
+    if (!dir.empty()) {
+      CollectLibraries(dir, files);
+    }
+  }
+  std::string stamp = ParserLibraryStamp() + ";";
+  for (const auto &file : files) {
+    stamp += file + "=" + FileStamp(file) + ";";
+  }
+  return stamp;
+}
+
+namespace {
+std::string Trim(const std::string &str) {
+  const char *const blanks = " \t\r\n";
+  size_t begin = str.find_first_not_of(blanks);
+  if (begin == std::string::npos) {
+    return "";
+  }
+  size_t end = str.find_last_not_of(blanks);
+  return str.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> EncodeOutNodes(const std::vector<std::pair<std::string, int32_t>> &out_nodes) {
+  std::vector<std::string> encoded;
+  for (const auto &out_node : out_nodes) {
+    encoded.emplace_back(out_node.first + ":" + std::to_string(out_node.second));
+  }
+  return encoded;
+}
+
+bool DecodeOutNodes(const std::vector<std::string> &encoded, std::vector<std::pair<std::string, int32_t>> &out_nodes) {
+  out_nodes.clear();
+  for (const auto &item : encoded) {
+    size_t pos = item.rfind(':');
+    if (pos == std::string::npos) {
+      return false;
+    }
+    try {
+      out_nodes.emplace_back(item.substr(0, pos), std::stoi(item.substr(pos + 1)));
+    } catch (...) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+Status ParseCache::Init(const std::vector<const char *> &model_files,
+                        const std::map<AscendString, AscendString> &parser_params,
+                        const std::vector<std::string> &extra_files) {
+  cache_file_.clear();
+  fingerprint_.clear();
+
+  std::string cache_dir;
+  std::string normalized_params;
+  // std::map keeps the params sorted by key, so the same options always give the same text
+  for (const auto &param : parser_params) {
+    const char *key = param.first.GetString();
+    const char *value = param.second.GetString();
+    if (key == nullptr) {
+      continue;
+    }
+    std::string value_str = (value == nullptr) ? "" : Trim(value);
+    if (std::string(key) == PARSE_CACHE_DIR) {
+      cache_dir = value_str;
+      continue;
+    }
+    normalized_params += std::string(key) + "=" + value_str + ";";
+  }
+  if (cache_dir.empty()) {
+    return SUCCESS;
+  }
+
+  if ((access(cache_dir.c_str(), F_OK) != 0) && (ModelSaver::CreateDirectory(cache_dir) != 0)) {
+    GELOGW("Can not create parse cache dir %s, parse cache is disabled.", cache_dir.c_str());
+    return SUCCESS;
+  }
+
+  std::string fingerprint = std::string("v") + kParseCacheVersion + "|fmk=" +
+                            std::to_string(static_cast<int>(GetParserContext().type));
+  for (const char *file : model_files) {
+    if (file == nullptr) {
+      continue;
+    }
+    uint64_t hash = 0;
+    int64_t size = 0;
+    if (!HashFile(file, hash, size)) {
+      GELOGE(FAILED, "Compute parse cache key of file %s failed.", file);
+      return FAILED;
+    }
+    fingerprint += "|" + std::to_string(size) + ":" + ToHex(hash);
+  }
+  for (const auto &file : extra_files) {
+    uint64_t hash = 0;
+    int64_t size = 0;
+    std::string stamp = FileStamp(file);
+    if ((stamp != "-") && !HashFile(file.c_str(), hash, size)) {
+      GELOGE(FAILED, "Compute parse cache key of file %s failed.", file.c_str());
+      return FAILED;
+    }
+    fingerprint += "|" + stamp + ":" + ToHex(hash);
+  }
+  fingerprint += "|" + normalized_params + "|" + GetLibrariesStamp();
+
+  uint64_t key = kFnvOffsetBasis;
+  Fnv1aUpdate(fingerprint.data(), fingerprint.size(), key);
+  fingerprint_ = fingerprint;
+  cache_file_ = cache_dir + "/" + ToHex(key) + kParseCacheSuffix;
+  GELOGI("Parse cache enabled, cache file: %s.", cache_file_.c_str());
+  return SUCCESS;
+}
+
+bool ParseCache::Load(ge::Graph &graph) const {
+  if (!IsEnabled() || access(cache_file_.c_str(), R_OK) != 0) {
+    return false;
+  }
+  char *data = nullptr;
+  int length = 0;
+  if (!ReadBytesFromBinaryFile(cache_file_.c_str(), &data, length)) {
+    GELOGW("Read parse cache file %s failed, parse model instead.", cache_file_.c_str());
+    return false;
+  }
+  ge::Model model;
+  graphStatus ret = ge::Model::Load(reinterpret_cast<const uint8_t *>(data), static_cast<size_t>(length), model);
+  delete[] data;
+  data = nullptr;
+  if (ret != GRAPH_SUCCESS) {
+    GELOGW("Parse cache file %s is broken, parse model instead.", cache_file_.c_str());
+    return false;
+  }
+
+  std::string fingerprint;
+  if (!AttrUtils::GetStr(&model, kAttrCacheFingerprint, fingerprint) || fingerprint != fingerprint_) {
+    GELOGW("Parse cache file %s does not match this conversion, parse model instead.", cache_file_.c_str());
+    return false;
+  }
+
+  int64_t format = 0;
+  std::vector<std::string> user_out_nodes;
+  std::vector<std::string> default_out_nodes;
+  std::vector<std::string> out_top_names;
+  std::vector<std::pair<std::string, int32_t>> decoded_user_out_nodes;
+  std::vector<std::pair<std::string, int32_t>> decoded_default_out_nodes;
+  if (!AttrUtils::GetInt(&model, kAttrCacheFormat, format) ||
+      !AttrUtils::GetListStr(&model, kAttrCacheUserOutNodes, user_out_nodes) ||
+      !AttrUtils::GetListStr(&model, kAttrCacheDefaultOutNodes, default_out_nodes) ||
+      !AttrUtils::GetListStr(&model, kAttrCacheOutTopNames, out_top_names) ||
+      !DecodeOutNodes(user_out_nodes, decoded_user_out_nodes) ||
+      !DecodeOutNodes(default_out_nodes, decoded_default_out_nodes)) {
+    GELOGW("Parser context in parse cache file %s is incomplete, parse model instead.", cache_file_.c_str());
+    return false;
+  }
+
+  graph = model.GetGraph();
+  GetParserContext().format = static_cast<domiTensorFormat_t>(format);
+  GetParserContext().user_out_nodes = decoded_user_out_nodes;
+  GetParserContext().default_out_nodes = decoded_default_out_nodes;
+  GetParserContext().out_top_names = out_top_names;
+  GELOGI("Parse cache hit, graph %s restored from %s.", graph.GetName().c_str(), cache_file_.c_str());
+  return true;
+}
+
+void ParseCache::Save(const ge::Graph &graph) const {
+  if (!IsEnabled()) {
+    return;
+  }
+  ge::Model model(graph.GetName(), "");
+  model.SetGraph(graph);
+  bool set_ret = AttrUtils::SetStr(&model, kAttrCacheFingerprint, fingerprint_) &&
+                 AttrUtils::SetInt(&model, kAttrCacheFormat, static_cast<int64_t>(GetParserContext().format)) &&
+                 AttrUtils::SetListStr(&model, kAttrCacheUserOutNodes,
+                                       EncodeOutNodes(GetParserContext().user_out_nodes)) &&
+                 AttrUtils::SetListStr(&model, kAttrCacheDefaultOutNodes,
+                                       EncodeOutNodes(GetParserContext().default_out_nodes)) &&
+                 AttrUtils::SetListStr(&model, kAttrCacheOutTopNames, GetParserContext().out_top_names);
+  ge::Buffer buffer;
+  if (!set_ret || model.Save(buffer) != GRAPH_SUCCESS || buffer.GetData() == nullptr) {
+    GELOGW("Serialize graph %s for parse cache failed.", graph.GetName().c_str());
+    return;
+  }
+
+  // Write to a private file first, concurrent conversions of the same model must never see half an entry
+  std::string tmp_file = cache_file_ + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream fs(tmp_file, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!fs.is_open()) {
+    GELOGW("Open parse cache file %s failed.", tmp_file.c_str());
+    return;
+  }
+  fs.write(reinterpret_cast<const char *>(buffer.GetData()), static_cast<std::streamsize>(buffer.GetSize()));
+  fs.close();
+  if (fs.fail() || rename(tmp_file.c_str(), cache_file_.c_str()) != 0) {
+    GELOGW("Write parse cache file %s failed.", cache_file_.c_str());
+    (void)remove(tmp_file.c_str());
+    return;
+  }
+  GELOGI("Graph %s saved to parse cache %s.", graph.GetName().c_str(), cache_file_.c_str());
+}
+}  // namespace parser
+}  // namespace ge
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_COMMON_PARSE_CACHE_H_
+#define PARSER_COMMON_PARSE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/ascend_string.h"
+#include "graph/graph.h"
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Paths, sizes and mtimes of the parser library, the custom op plugins and the op proto libs. They decide
+///        how ops are parsed, so results kept across parses are stale once the stamp changes.
+///
+std::string GetLibrariesStamp();
+
+///
+/// @ingroup domi_omg
+/// @brief On-disk cache of parsed graphs, enabled by the parser option parse_cache_dir.
+///        An entry is keyed by the model file bytes, the bytes and mtime of the other files the parser reads,
+///        the framework type, the normalized parser params and the size and mtime of the parser library and of
+///        the loaded custom op plugins and op proto libs. It holds the parsed graph as a ge_ir ModelDef together
+///        with the parser context the output node handling depends on.
+///
+class ParseCache {
+ public:
+  ParseCache() = default;
+  ~ParseCache() = default;
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Compute the cache entry of this conversion. The cache stays disabled without parse_cache_dir.
+  /// @param [in] model_files files whose content makes up the key, nullptr entries are skipped
+  /// @param [in] parser_params parser params of this conversion
+  /// @param [in] extra_files other files the parser may read, such as a function library, missing is allowed
+  /// @return SUCCESS cache disabled or initialized
+  /// @return FAILED model file can not be read
+  ///
+  Status Init(const std::vector<const char *> &model_files, const std::map<AscendString, AscendString> &parser_params,
+              const std::vector<std::string> &extra_files = {});
+
+  bool IsEnabled() const { return !cache_file_.empty(); }
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Restore the graph and parser context saved by an earlier identical conversion
+  /// @param [out] graph parsed graph
+  /// @return true cache hit, false otherwise
+  ///
+  bool Load(ge::Graph &graph) const;
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Save the parsed graph and parser context. Failures only disable caching of this conversion.
+  /// @param [in] graph parsed graph
+  ///
+  void Save(const ge::Graph &graph) const;
+
+ private:
+  std::string cache_file_;
+  std::string fingerprint_;
+};
+}  // namespace parser
+}  // namespace ge
+
+#endif  // PARSER_COMMON_PARSE_CACHE_H_
@@ -0,0 +1,42 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/common/parse_options.h"
+
+namespace ge {
+namespace parser {
+namespace {
+thread_local ParseOptionsPtr g_current_options;
+
+const ParseOptions &GetDefaultParseOptions() {
+  static const ParseOptions default_options;
+  return default_options;
+}
+}  // namespace
+
+const ParseOptions &GetParseOptions() {
+  return (g_current_options != nullptr) ? *g_current_options : GetDefaultParseOptions();
+}
+
+ParseOptionsPtr GetParseOptionsPtr() { return g_current_options; }
+
+ParseOptionsScope::ParseOptionsScope(const ParseOptionsPtr &options) : previous_(g_current_options) {
+  g_current_options = options;
+}
+
+ParseOptionsScope::~ParseOptionsScope() { g_current_options = previous_; }
+}  // namespace parser
+}  // namespace ge
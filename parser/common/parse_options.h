@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_COMMON_PARSE_OPTIONS_H_
+#define PARSER_COMMON_PARSE_OPTIONS_H_
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "external/graph/types.h"
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Parser options that only hold for one conversion. AclGrphParseUtil::ParseParamsBeforeGraph fills them
+///        and the aclgrphParse entry installs them on its thread with ParseOptionsScope, ThreadPool tasks run
+///        with the options of the thread that committed them. Without a scope the defaults apply.
+///
+struct ParseOptions {
+  // DT_FLOAT16 stores fp32 weights as fp16, see WeightPrecision
+  ge::DataType weight_precision = ge::DT_FLOAT;
+  // Const nodes or Caffe layers whose weights keep fp32
+  std::set<std::string> weight_precision_exclude_nodes;
+  // the tensorflow parser folds static shape subgraphs to Const nodes, see TensorFlowShapeFolding
+  bool shape_folding = false;
+};
+using ParseOptionsPtr = std::shared_ptr<const ParseOptions>;
+
+///
+/// @ingroup domi_omg
+/// @brief Options of the conversion running on the calling thread
+///
+const ParseOptions &GetParseOptions();
+ParseOptionsPtr GetParseOptionsPtr();
+
+///
+/// @ingroup domi_omg
+/// @brief Installs options on the calling thread for its lifetime and restores the previous ones after
+///
+class ParseOptionsScope {
+ public:
+  explicit ParseOptionsScope(const ParseOptionsPtr &options);
+  ~ParseOptionsScope();
+  ParseOptionsScope(const ParseOptionsScope &) = delete;
+  ParseOptionsScope &operator=(const ParseOptionsScope &) = delete;
+
+ private:
+  ParseOptionsPtr previous_;
+};
+}  // namespace parser
+}  // namespace ge
+
+#endif  // PARSER_COMMON_PARSE_OPTIONS_H_
@@ -38,11 +38,9 @@ Status ParserInitialize(const std::map<std::string, std::string> &options) {
   // load custom op plugin
   TBEPluginLoader::Instance().LoadPluginSo(options);
 
-  std::vector<OpRegistrationData> registrationDatas = domi::OpRegistry::Instance()->registrationDatas;
-  GELOGI("The size of registrationDatas in parser is: %zu", registrationDatas.size());
-  for (OpRegistrationData &reg_data : registrationDatas) {
+  TBEPluginLoader::Instance().FinalizeRegistrations([](const OpRegistrationData &reg_data) {
     (void)OpRegistrationTbe::Instance()->Finalize(reg_data, true);
-  }
+  });
 
   auto iter = options.find(ge::OPTION_EXEC_ENABLE_SCOPE_FUSION_PASSES);
   if (iter != options.end()) {
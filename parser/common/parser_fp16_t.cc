@@ -18,8 +18,20 @@
 
 #include "external/register/register_types.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define PARSER_FP16_F16C
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define PARSER_FP16_NEON
+#include <arm_neon.h>
+#endif
+
 namespace {
 constexpr uint16_t kManBitLength = 11;
+// Lanes converted per vector step of the array conversions
+constexpr size_t kFp16VecLen = 8;
+// Largest finite fp16, the scalar conversion saturates beyond it where IEEE 754 gives inf
+constexpr float kFp16MaxFloat = 65504.0f;
 }
 namespace ge {
 namespace parser {
@@ -480,6 +492,29 @@ static uint32_t Fp16ToUInt32(const uint16_t &fp_val) {
   return m_ret;
 }
 
+/// @ingroup fp16_t math conversion static method
+/// @param [in] fp_val uint16_t value of fp16_t object
+/// @brief   Convert fp16_t to int64_t
+/// @return  Return int64_t value of fp_val which is the value of fp16_t object
+static int64_t Fp16ToInt64(const uint16_t &fp_val) {
+  if (FP16_IS_INVALID(fp_val)) {  // Inf or NaN
+    return (FP16_EXTRAC_SIGN(fp_val) == 1) ? (-kInt64Max - 1) : kInt64Max;
+  }
+  // Every finite fp16_t value fits in int32_t
+  return static_cast<int64_t>(Fp16ToInt32(fp_val));
+}
+
+/// @ingroup fp16_t math conversion static method
+/// @param [in] fp_val uint16_t value of fp16_t object
+/// @brief   Convert fp16_t to uint64_t
+/// @return  Return uint64_t value of fp_val which is the value of fp16_t object
+static uint64_t Fp16ToUInt64(const uint16_t &fp_val) {
+  if (FP16_IS_INVALID(fp_val) && (FP16_EXTRAC_SIGN(fp_val) == 0)) {  // +Inf or NaN
+    return kBitLen64Max;
+  }
+  return static_cast<uint64_t>(Fp16ToUInt32(fp_val));
+}
+
 static uint16_t Fp16AddCalVal(uint16_t &s_ret, int16_t e_ret, uint16_t m_ret, uint32_t m_trunc, uint16_t shift_out) {
   uint16_t m_min = kFp16ManHideBit << shift_out;
   uint16_t m_max = m_min << 1;
@@ -1157,6 +1192,18 @@ fp16_t &fp16_t::operator=(const uint32_t &ui_val) {
   return *this;
 }
 
+fp16_t &fp16_t::operator=(const int64_t &i_val) {
+  // Beyond the int32_t range the result saturates like it does for large int32_t values
+  int32_t i32_val = static_cast<int32_t>(std::max(std::min(i_val, static_cast<int64_t>(kInt32Max)),
+                                                  -static_cast<int64_t>(kInt32Max)));
+  return *this = i32_val;
+}
+
+fp16_t &fp16_t::operator=(const uint64_t &ui_val) {
+  uint32_t ui32_val = static_cast<uint32_t>(std::min(ui_val, static_cast<uint64_t>(kBitLen32Max)));
+  return *this = ui32_val;
+}
+
 fp16_t &fp16_t::operator=(const double &d_val) {
   uint16_t s_ret;
   uint16_t m_ret;
@@ -1233,11 +1280,9 @@ fp16_t::operator int32_t() const { return Fp16ToInt32(val); }
 
 fp16_t::operator uint32_t() const { return Fp16ToUInt32(val); }
 
-// Cannot be used, just in order to solve the compile error
-fp16_t::operator int64_t() const { return 0; }
+fp16_t::operator int64_t() const { return Fp16ToInt64(val); }
 
-// Cannot be used, just in order to solve the compile error
-fp16_t::operator uint64_t() const { return 0; }
+fp16_t::operator uint64_t() const { return Fp16ToUInt64(val); }
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY int fp16_t::IsInf() {
   if ((val & kFp16AbsMax) == kFp16ExpMask) {
@@ -1266,5 +1311,202 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY uint16_t fp16_t::ToUInt16() con
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY int32_t fp16_t::ToInt32() const { return Fp16ToInt32(val); }
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY uint32_t fp16_t::ToUInt32() const { return Fp16ToUInt32(val); }
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY int64_t fp16_t::ToInt64() const { return Fp16ToInt64(val); }
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY uint64_t fp16_t::ToUInt64() const { return Fp16ToUInt64(val); }
+
+static uint16_t FloatToFp16(const float &f_val) {
+  fp16_t fp;
+  fp = f_val;
+  return fp.val;
+}
+
+static uint16_t DoubleToFp16(const double &d_val) {
+  fp16_t fp;
+  fp = d_val;
+  return fp.val;
+}
+
+/// @ingroup fp16_t array conversion
+/// @brief   Scalar conversion of the elements [begin, end), the tail and the fallback of the vector paths
+template <typename SrcT, typename DstT, DstT (*Convert)(const SrcT &)>
+static void ConvertRange(const SrcT *src, DstT *dst, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    dst[i] = Convert(src[i]);
+  }
+}
+
+// The vector paths convert whole steps of kFp16VecLen and return how many elements they converted
+#if defined(PARSER_FP16_F16C)
+static bool HasFp16Vec() {
+  static const bool has_fp16_vec = (__builtin_cpu_supports("avx") != 0) && (__builtin_cpu_supports("f16c") != 0);
+  return has_fp16_vec;
+}
+
+__attribute__((target("avx,f16c"))) static size_t Fp16ToFloatVec(const uint16_t *src, float *dst, size_t len) {
+  const __m128i exp_mask = _mm_set1_epi16(static_cast<int16_t>(kFp16ExpMask));
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i invalid = _mm_cmpeq_epi16(_mm_and_si128(half, exp_mask), exp_mask);
+    if (_mm_movemask_epi8(invalid) != 0) {
+      ConvertRange<uint16_t, float, Fp16ToFloat>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+  }
+  return i;
+}
+
+__attribute__((target("avx,f16c"))) static size_t FloatToFp16Vec(const float *src, uint16_t *dst, size_t len) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(kFp32AbsMax)));
+  const __m256 max_val = _mm256_set1_ps(kFp16MaxFloat);
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    __m256 f_val = _mm256_loadu_ps(src + i);
+    // Ordered compare, NaN lanes are out of range too
+    __m256 in_range = _mm256_cmp_ps(_mm256_and_ps(f_val, abs_mask), max_val, _CMP_LE_OQ);
+    if (_mm256_movemask_ps(in_range) != 0xFF) {
+      ConvertRange<float, uint16_t, FloatToFp16>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm256_cvtps_ph(f_val, _MM_FROUND_TO_NEAREST_INT));
+  }
+  return i;
+}
+
+__attribute__((target("avx,f16c"))) static size_t Fp16ToInt32Vec(const uint16_t *src, int32_t *dst, size_t len) {
+  const __m128i exp_mask = _mm_set1_epi16(static_cast<int16_t>(kFp16ExpMask));
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i invalid = _mm_cmpeq_epi16(_mm_and_si128(half, exp_mask), exp_mask);
+    if (_mm_movemask_epi8(invalid) != 0) {
+      ConvertRange<uint16_t, int32_t, Fp16ToInt32>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    __m256 rounded = _mm256_round_ps(_mm256_cvtph_ps(half), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvttps_epi32(rounded));
+  }
+  return i;
+}
+#elif defined(PARSER_FP16_NEON)
+static bool HasFp16Vec() { return true; }
+
+static size_t Fp16ToFloatVec(const uint16_t *src, float *dst, size_t len) {
+  const uint16x8_t exp_mask = vdupq_n_u16(kFp16ExpMask);
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    uint16x8_t half = vld1q_u16(src + i);
+    uint16x8_t invalid = vceqq_u16(vandq_u16(half, exp_mask), exp_mask);
+    if (vmaxvq_u16(invalid) != 0) {
+      ConvertRange<uint16_t, float, Fp16ToFloat>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(half))));
+    vst1q_f32(dst + i + kFp16VecLen / 2, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(half))));
+  }
+  return i;
+}
+
+static size_t FloatToFp16Vec(const float *src, uint16_t *dst, size_t len) {
+  const float32x4_t max_val = vdupq_n_f32(kFp16MaxFloat);
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    float32x4_t low = vld1q_f32(src + i);
+    float32x4_t high = vld1q_f32(src + i + kFp16VecLen / 2);
+    // Absolute compare is false for NaN lanes
+    uint32x4_t in_range = vandq_u32(vcaleq_f32(low, max_val), vcaleq_f32(high, max_val));
+    if (vminvq_u32(in_range) == 0) {
+      ConvertRange<float, uint16_t, FloatToFp16>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    uint16x8_t half = vcombine_u16(vreinterpret_u16_f16(vcvt_f16_f32(low)), vreinterpret_u16_f16(vcvt_f16_f32(high)));
+    vst1q_u16(dst + i, half);
+  }
+  return i;
+}
+
+static size_t Fp16ToInt32Vec(const uint16_t *src, int32_t *dst, size_t len) {
+  const uint16x8_t exp_mask = vdupq_n_u16(kFp16ExpMask);
+  size_t i = 0;
+  for (; i + kFp16VecLen <= len; i += kFp16VecLen) {
+    uint16x8_t half = vld1q_u16(src + i);
+    uint16x8_t invalid = vceqq_u16(vandq_u16(half, exp_mask), exp_mask);
+    if (vmaxvq_u16(invalid) != 0) {
+      ConvertRange<uint16_t, int32_t, Fp16ToInt32>(src, dst, i, i + kFp16VecLen);
+      continue;
+    }
+    vst1q_s32(dst + i, vcvtnq_s32_f32(vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(half)))));
+    vst1q_s32(dst + i + kFp16VecLen / 2, vcvtnq_s32_f32(vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(half)))));
+  }
+  return i;
+}
+#endif
+
+void Fp16ToFloatArray(const uint16_t *src, float *dst, size_t len) {
+  size_t done = 0;
+#if defined(PARSER_FP16_F16C) || defined(PARSER_FP16_NEON)
+  if (HasFp16Vec()) {
+    done = Fp16ToFloatVec(src, dst, len);
+  }
+#endif
+  ConvertRange<uint16_t, float, Fp16ToFloat>(src, dst, done, len);
+}
+
+void FloatToFp16Array(const float *src, uint16_t *dst, size_t len) {
+  size_t done = 0;
+#if defined(PARSER_FP16_F16C) || defined(PARSER_FP16_NEON)
+  // The instructions round to nearest even, the scalar conversion is the only one that truncates
+  if (HasFp16Vec() && (g_round_mode == kRoundToNearest)) {
+    done = FloatToFp16Vec(src, dst, len);
+  }
+#endif
+  ConvertRange<float, uint16_t, FloatToFp16>(src, dst, done, len);
+}
+
+void DoubleToFp16Array(const double *src, uint16_t *dst, size_t len) {
+  // Narrowing to float first would round twice, doubles keep the scalar conversion
+  ConvertRange<double, uint16_t, DoubleToFp16>(src, dst, 0, len);
+}
+
+void Fp16ToInt8Array(const uint16_t *src, int8_t *dst, size_t len) {
+  ConvertRange<uint16_t, int8_t, Fp16ToInt8>(src, dst, 0, len);
+}
+
+void Fp16ToUInt8Array(const uint16_t *src, uint8_t *dst, size_t len) {
+  ConvertRange<uint16_t, uint8_t, Fp16ToUInt8>(src, dst, 0, len);
+}
+
+void Fp16ToInt16Array(const uint16_t *src, int16_t *dst, size_t len) {
+  ConvertRange<uint16_t, int16_t, Fp16ToInt16>(src, dst, 0, len);
+}
+
+void Fp16ToUInt16Array(const uint16_t *src, uint16_t *dst, size_t len) {
+  ConvertRange<uint16_t, uint16_t, Fp16ToUInt16>(src, dst, 0, len);
+}
+
+void Fp16ToInt32Array(const uint16_t *src, int32_t *dst, size_t len) {
+  size_t done = 0;
+#if defined(PARSER_FP16_F16C) || defined(PARSER_FP16_NEON)
+  if (HasFp16Vec() && (g_round_mode == kRoundToNearest)) {
+    done = Fp16ToInt32Vec(src, dst, len);
+  }
+#endif
+  ConvertRange<uint16_t, int32_t, Fp16ToInt32>(src, dst, done, len);
+}
+
+void Fp16ToUInt32Array(const uint16_t *src, uint32_t *dst, size_t len) {
+  ConvertRange<uint16_t, uint32_t, Fp16ToUInt32>(src, dst, 0, len);
+}
+
+void Fp16ToInt64Array(const uint16_t *src, int64_t *dst, size_t len) {
+  ConvertRange<uint16_t, int64_t, Fp16ToInt64>(src, dst, 0, len);
+}
+
+void Fp16ToUInt64Array(const uint16_t *src, uint64_t *dst, size_t len) {
+  ConvertRange<uint16_t, uint64_t, Fp16ToUInt64>(src, dst, 0, len);
+}
 }  // namespace parser
 }  // namespace ge
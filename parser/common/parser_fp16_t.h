@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 namespace ge {
@@ -449,6 +450,18 @@ public:
   /// @return  Return fp16_t result from ui_val
   TagFp16 &operator=(const uint32_t &ui_val);
 
+  /// @ingroup fp16_t math evaluation operator
+  /// @param [in] i_val int64_t object to be converted to fp16_t
+  /// @brief   Override basic evaluation operator to convert int64_t to fp16_t
+  /// @return  Return fp16_t result from i_val
+  TagFp16 &operator=(const int64_t &i_val);
+
+  /// @ingroup fp16_t math evaluation operator
+  /// @param [in] ui_val uint64_t object to be converted to fp16_t
+  /// @brief   Override basic evaluation operator to convert uint64_t to fp16_t
+  /// @return  Return fp16_t result from ui_val
+  TagFp16 &operator=(const uint64_t &ui_val);
+
   /// @ingroup fp16_t math conversion
   /// @brief   Override convert operator to convert fp16_t to float/fp32
   /// @return  Return float/fp32 value of fp16_t
@@ -544,8 +557,37 @@ public:
   /// @brief   Convert fp16_t to uint32_t
   /// @return  Return uint32_t value of fp16_t
   uint32_t ToUInt32() const;
+
+  /// @ingroup fp16_t math conversion
+  /// @brief   Convert fp16_t to int64_t
+  /// @return  Return int64_t value of fp16_t
+  int64_t ToInt64() const;
+
+  /// @ingroup fp16_t math conversion
+  /// @brief   Convert fp16_t to uint64_t
+  /// @return  Return uint64_t value of fp16_t
+  uint64_t ToUInt64() const;
 };
 
+/// @ingroup fp16_t array conversion
+/// @param [in]  src fp16_t values, len elements
+/// @param [out] dst converted values, len elements
+/// @param [in]  len element count
+/// @brief   Convert arrays with the same results as the scalar conversions of fp16_t. F16C or NEON
+///          instructions are used when the cpu has them, lanes the scalar conversion treats differently
+///          from IEEE 754 (fp16 inf/NaN, floats beyond the fp16 range) fall back to the scalar conversion
+void Fp16ToFloatArray(const uint16_t *src, float *dst, size_t len);
+void FloatToFp16Array(const float *src, uint16_t *dst, size_t len);
+void DoubleToFp16Array(const double *src, uint16_t *dst, size_t len);
+void Fp16ToInt8Array(const uint16_t *src, int8_t *dst, size_t len);
+void Fp16ToUInt8Array(const uint16_t *src, uint8_t *dst, size_t len);
+void Fp16ToInt16Array(const uint16_t *src, int16_t *dst, size_t len);
+void Fp16ToUInt16Array(const uint16_t *src, uint16_t *dst, size_t len);
+void Fp16ToInt32Array(const uint16_t *src, int32_t *dst, size_t len);
+void Fp16ToUInt32Array(const uint16_t *src, uint32_t *dst, size_t len);
+void Fp16ToInt64Array(const uint16_t *src, int64_t *dst, size_t len);
+void Fp16ToUInt64Array(const uint16_t *src, uint64_t *dst, size_t len);
+
 /// @ingroup fp16_t public method
 /// @param [in]     val signature is negative
 /// @param [in|out] s   sign of fp16_t object
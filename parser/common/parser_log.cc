@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/common/parser_log.h"
+
+#include <cstdlib>
+
+#include "parser/common/acl_graph_parser_util.h"
+
+namespace ge {
+namespace parser {
+namespace {
+const size_t kTraceRingSize = 8192;
+}  // namespace
+
+ParserTrace &ParserTrace::Instance() {
+  static ParserTrace instance;
+  return instance;
+}
+
+void ParserTrace::Start(const std::map<AscendString, AscendString> &parser_params) {
+  std::string sample_str;
+  for (const auto &param : parser_params) {
+    const char *key = param.first.GetString();
+    const char *value = param.second.GetString();
+    if ((key != nullptr) && (value != nullptr) && (std::string(key) == PARSER_TRACE_SAMPLE)) {
+      sample_str = value;
+      break;
+    }
+  }
+  if (sample_str.empty()) {
+    return;
+  }
+  char *end = nullptr;
+  unsigned long long sample = strtoull(sample_str.c_str(), &end, 10);
+  if ((end == nullptr) || (*end != '\0') || (sample == 0)) {
+    GELOGW("Invalid %s %s, expect a positive integer, parser trace is off.", PARSER_TRACE_SAMPLE, sample_str.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (IsEnabled()) {
+    GELOGW("Parser trace is already running, ignore %s %s.", PARSER_TRACE_SAMPLE, sample_str.c_str());
+    return;
+  }
+  sample_.store(sample, std::memory_order_relaxed);
+  event_count_.store(0, std::memory_order_relaxed);
+  ring_.clear();
+  ring_.reserve(kTraceRingSize);
+  ring_next_ = 0;
+  // Release pairs with the acquire in IsEnabled, so Record sees sample_ of this run
+  enabled_.store(true, std::memory_order_release);
+  GELOGI("Parser trace started, keep one of every %llu events.", sample);
+}
+
+void ParserTrace::Record(const char *event, const std::string &name, int64_t arg0, int64_t arg1) {
+  uint64_t seq = event_count_.fetch_add(1, std::memory_order_relaxed);
+  uint64_t sample = sample_.load(std::memory_order_relaxed);
+  if ((sample > 1) && ((seq % sample) != 0)) {
+    return;
+  }
+  TraceEvent trace_event = {seq, GetCurrentTimestamp(), event, name, arg0, arg1};
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsEnabled()) {
+    return;
+  }
+  if (ring_.size() < kTraceRingSize) {
+    ring_.push_back(std::move(trace_event));
+  } else {
+    ring_[ring_next_] = std::move(trace_event);
+  }
+  ring_next_ = (ring_next_ + 1) % kTraceRingSize;
+}
+
+void ParserTrace::Finish() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsEnabled()) {
+    return;
+  }
+  enabled_.store(false, std::memory_order_relaxed);
+  uint64_t total = event_count_.load(std::memory_order_relaxed);
+  GELOGI("Parser trace: %llu events, %zu retained.", static_cast<unsigned long long>(total), ring_.size());
+  // Oldest first: once the ring wrapped, the oldest event sits at ring_next_
+  size_t first = (ring_.size() < kTraceRingSize) ? 0 : ring_next_;
+  for (size_t i = 0; i < ring_.size(); ++i) {
+    const TraceEvent &trace_event = ring_[(first + i) % ring_.size()];
+    GELOGI("Parser trace #%llu %llu us %s %s %lld %lld.", static_cast<unsigned long long>(trace_event.seq),
+           static_cast<unsigned long long>(trace_event.ts_us), trace_event.event, trace_event.name.c_str(),
+           static_cast<long long>(trace_event.arg0), static_cast<long long>(trace_event.arg1));
+  }
+  ring_.clear();
+  ring_.shrink_to_fit();
+}
+}  // namespace parser
+}  // namespace ge
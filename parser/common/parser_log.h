@@ -0,0 +1,113 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_COMMON_PARSER_LOG_H_
+#define PARSER_COMMON_PARSER_LOG_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "graph/ascend_string.h"
+
+// Per node and per edge logs: the arguments are only evaluated when the level is enabled
+#define PARSER_LOG_ENABLED(level) (IsLogEnable(GE_MODULE_NAME, (level)) == 1)
+
+#define PARSER_LOGD(fmt, ...)                 \
+  do {                                        \
+    if (PARSER_LOG_ENABLED(DLOG_DEBUG)) {     \
+      GELOGD(fmt, ##__VA_ARGS__);             \
+    }                                         \
+  } while (0)
+
+#define PARSER_LOGI(fmt, ...)                 \
+  do {                                        \
+    if (PARSER_LOG_ENABLED(DLOG_INFO)) {      \
+      GELOGI(fmt, ##__VA_ARGS__);             \
+    }                                         \
+  } while (0)
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Flight recorder of per node and per edge parse events. Enabled by the parser option
+///        parser_trace_sample=N, which keeps one of every N events in a ring of the latest ones.
+///        The ring is written to the INFO log when the conversion ends, instead of one log line per event.
+///
+class ParserTrace {
+ public:
+  static ParserTrace &Instance();
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Start tracing if parser_params contains parser_trace_sample
+  ///
+  void Start(const std::map<AscendString, AscendString> &parser_params);
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Stop tracing and write the retained events to the log
+  ///
+  void Finish();
+
+  bool IsEnabled() const { return enabled_.load(std::memory_order_acquire); }
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Record an event, use PARSER_TRACE so that nothing is evaluated when tracing is off
+  /// @param [in] event static event name
+  /// @param [in] name node or edge the event is about
+  /// @param [in] arg0, arg1 event specific values, such as anchor indexes
+  ///
+  void Record(const char *event, const std::string &name, int64_t arg0, int64_t arg1);
+
+ private:
+  struct TraceEvent {
+    uint64_t seq;
+    uint64_t ts_us;
+    const char *event;
+    std::string name;
+    int64_t arg0;
+    int64_t arg1;
+  };
+
+  ParserTrace() = default;
+  ~ParserTrace() = default;
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> event_count_{0};
+  // Read by Record without mutex_, never 0
+  std::atomic<uint64_t> sample_{1};
+  std::mutex mutex_;
+  std::vector<TraceEvent> ring_;
+  size_t ring_next_ = 0;
+};
+}  // namespace parser
+}  // namespace ge
+
+#define PARSER_TRACE(event, name, arg0, arg1)                                                   \
+  do {                                                                                          \
+    if (ge::parser::ParserTrace::Instance().IsEnabled()) {                                      \
+      ge::parser::ParserTrace::Instance().Record((event), (name), static_cast<int64_t>(arg0),   \
+                                                 static_cast<int64_t>(arg1));                   \
+    }                                                                                           \
+  } while (0)
+
+#endif  // PARSER_COMMON_PARSER_LOG_H_
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/common/parser_profiler.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "framework/common/debug/ge_log.h"
+#include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/model_saver.h"
+
+namespace ge {
+namespace parser {
+namespace {
+// Bounds the trace of huge graphs, op type counters keep counting beyond it
+const size_t kMaxSpanEvents = 2000000;
+
+int64_t GetPeakRssKb() {
+  struct rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  // ru_maxrss is in kilobytes on linux
+  return static_cast<int64_t>(usage.ru_maxrss);
+}
+}  // namespace
+
+ParserProfiler &ParserProfiler::Instance() {
+  static ParserProfiler instance;
+  return instance;
+}
+
+void ParserProfiler::Start(const std::map<AscendString, AscendString> &parser_params) {
+  std::string output_file;
+  for (const auto &param : parser_params) {
+    const char *key = param.first.GetString();
+    const char *value = param.second.GetString();
+    if ((key != nullptr) && (value != nullptr) && (std::string(key) == PARSER_PROFILING_FILE)) {
+      output_file = value;
+      break;
+    }
+  }
+  if (output_file.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (IsEnabled()) {
+    GELOGW("Parser profiling is already running, ignore profiling file %s.", output_file.c_str());
+    return;
+  }
+  output_file_ = output_file;
+  buffers_.clear();
+  span_count_.store(0, std::memory_order_relaxed);
+  start_us_ = GetCurrentTimestamp();
+  start_peak_rss_kb_ = GetPeakRssKb();
+  generation_.fetch_add(1, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+  GELOGI("Parser profiling started, trace will be written to %s.", output_file_.c_str());
+}
+
+ParserProfiler::ThreadBuffer *ParserProfiler::GetThreadBuffer() {
+  struct LocalBuffer {
+    uint64_t generation = 0;
+    std::shared_ptr<ThreadBuffer> buffer;
+  };
+  static thread_local LocalBuffer local;
+  if ((local.buffer == nullptr) || (local.generation != generation_.load(std::memory_order_relaxed))) {
+    // Once per thread and profiling session, later spans of the thread only take its own buffer mutex
+    std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer->tid = static_cast<uint32_t>(buffers_.size());
+    buffers_.push_back(buffer);
+    local.generation = generation_.load(std::memory_order_relaxed);
+    local.buffer = buffer;
+  }
+  return local.buffer.get();
+}
+
+void ParserProfiler::AddSpan(const std::string &name, uint64_t start_us, uint64_t end_us,
+                             const std::string &op_type) {
+  if (!IsEnabled()) {
+    return;
+  }
+  uint64_t dur_us = (end_us > start_us) ? (end_us - start_us) : 0;
+  // Stage spans are few, sample memory at the end of each of them
+  int64_t peak_rss_kb = op_type.empty() ? GetPeakRssKb() : -1;
+  bool keep_span = span_count_.fetch_add(1, std::memory_order_relaxed) < kMaxSpanEvents;
+
+  ThreadBuffer *buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer->mutex);
+  if (!op_type.empty()) {
+    OpTypeStat &stat = buffer->op_type_stats[op_type];
+    stat.count++;
+    stat.total_us += dur_us;
+  }
+  if (peak_rss_kb >= 0) {
+    buffer->memory_samples.push_back({end_us, peak_rss_kb});
+  }
+  if (keep_span) {
+    buffer->spans.push_back({name, op_type, buffer->tid, start_us, dur_us});
+  } else {
+    buffer->dropped_spans++;
+  }
+}
+
+std::map<std::string, uint64_t> ParserProfiler::GetStageCost() {
+  std::map<std::string, uint64_t> stage_cost;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    for (const auto &span : buffer->spans) {
+      if (span.op_type.empty()) {
+        stage_cost[span.name] += span.dur_us;
+      }
+    }
+  }
+  return stage_cost;
+}
+
+Status ParserProfiler::Finish() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsEnabled()) {
+    return SUCCESS;
+  }
+  enabled_.store(false, std::memory_order_relaxed);
+
+  std::vector<SpanEvent> spans;
+  std::vector<MemorySample> memory_samples = {{start_us_, start_peak_rss_kb_}};
+  std::map<std::string, OpTypeStat> op_type_stats;
+  uint64_t dropped_spans = 0;
+  for (const auto &buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    spans.insert(spans.end(), buffer->spans.begin(), buffer->spans.end());
+    memory_samples.insert(memory_samples.end(), buffer->memory_samples.begin(), buffer->memory_samples.end());
+    for (const auto &stat : buffer->op_type_stats) {
+      op_type_stats[stat.first].count += stat.second.count;
+      op_type_stats[stat.first].total_us += stat.second.total_us;
+    }
+    dropped_spans += buffer->dropped_spans;
+  }
+  buffers_.clear();
+  std::sort(memory_samples.begin(), memory_samples.end(),
+            [](const MemorySample &lhs, const MemorySample &rhs) { return lhs.ts_us < rhs.ts_us; });
+  memory_samples.push_back({GetCurrentTimestamp(), GetPeakRssKb()});
+
+  uint64_t base_us = start_us_;
+  int32_t pid = static_cast<int32_t>(getpid());
+  Json trace_events = Json::array();
+  for (const auto &span : spans) {
+    Json event;
+    event["name"] = span.name;
+    event["cat"] = span.op_type.empty() ? "stage" : "node";
+    event["ph"] = "X";
+    event["pid"] = pid;
+    event["tid"] = span.tid;
+    event["ts"] = (span.start_us > base_us) ? (span.start_us - base_us) : 0;
+    event["dur"] = span.dur_us;
+    if (!span.op_type.empty()) {
+      event["args"]["op_type"] = span.op_type;
+    }
+    trace_events.push_back(event);
+  }
+  for (const auto &sample : memory_samples) {
+    Json event;
+    event["name"] = "peak_rss";
+    event["ph"] = "C";
+    event["pid"] = pid;
+    event["ts"] = (sample.ts_us > base_us) ? (sample.ts_us - base_us) : 0;
+    event["args"]["peak_rss_kb"] = sample.peak_rss_kb;
+    trace_events.push_back(event);
+  }
+
+  Json op_type_stats_json = Json::object();
+  for (const auto &stat : op_type_stats) {
+    op_type_stats_json[stat.first]["count"] = stat.second.count;
+    op_type_stats_json[stat.first]["total_us"] = stat.second.total_us;
+  }
+
+  Json trace;
+  trace["traceEvents"] = trace_events;
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"]["op_type_stats"] = op_type_stats_json;
+  trace["otherData"]["peak_rss_kb"] = memory_samples.back().peak_rss_kb;
+  trace["otherData"]["dropped_spans"] = dropped_spans;
+
+  Status ret = ModelSaver::SaveJsonToFile(output_file_.c_str(), trace);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Write parser profiling file %s failed.", output_file_.c_str());
+  } else {
+    GELOGI("Parser profiling written to %s, %zu spans.", output_file_.c_str(), spans.size());
+  }
+  return ret;
+}
+
+ParserProfileScope::ParserProfileScope(const char *name)
+    : name_(name), start_us_(ParserProfiler::Instance().IsEnabled() ? GetCurrentTimestamp() : 0) {}
+
+ParserProfileScope::~ParserProfileScope() {
+  if (start_us_ != 0) {
+    ParserProfiler::Instance().AddSpan(name_, start_us_, GetCurrentTimestamp(), op_type_);
+  }
+}
+}  // namespace parser
+}  // namespace ge
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_COMMON_PARSER_PROFILER_H_
+#define PARSER_COMMON_PARSER_PROFILER_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/ascend_string.h"
+#include "parser/common/parser_log.h"
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Collects parse stage spans, per op type parse counters and peak RSS samples of one conversion,
+///        and writes them as a Chrome trace (chrome://tracing, Perfetto) JSON file.
+///        Enabled by the parser option parser_profiling_file, otherwise every call returns immediately.
+///
+class ParserProfiler {
+ public:
+  static ParserProfiler &Instance();
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Start profiling if parser_params contains parser_profiling_file
+  ///
+  void Start(const std::map<AscendString, AscendString> &parser_params);
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Stop profiling and write the trace file
+  ///
+  Status Finish();
+
+  bool IsEnabled() const { return enabled_.load(std::memory_order_acquire); }
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Record a span on the calling thread. Spans nest by time, so stages inside a stage show up as children.
+  /// @param [in] name span name
+  /// @param [in] start_us, end_us timestamps from GetCurrentTimestamp
+  /// @param [in] op_type not empty for the parse of a single node, counted per framework op type
+  ///
+  void AddSpan(const std::string &name, uint64_t start_us, uint64_t end_us, const std::string &op_type = "");
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Total time of the stage spans recorded since Start, keyed by span name. Call before Finish.
+  ///
+  std::map<std::string, uint64_t> GetStageCost();
+
+ private:
+  struct SpanEvent {
+    std::string name;
+    std::string op_type;
+    uint32_t tid;
+    uint64_t start_us;
+    uint64_t dur_us;
+  };
+  struct MemorySample {
+    uint64_t ts_us;
+    int64_t peak_rss_kb;
+  };
+  struct OpTypeStat {
+    uint64_t count = 0;
+    uint64_t total_us = 0;
+  };
+  // Events of one thread, merged by Finish. Its mutex is only contended while Finish merges.
+  struct ThreadBuffer {
+    std::mutex mutex;
+    uint32_t tid = 0;
+    std::vector<SpanEvent> spans;
+    std::vector<MemorySample> memory_samples;
+    std::map<std::string, OpTypeStat> op_type_stats;
+    uint64_t dropped_spans = 0;
+  };
+
+  ParserProfiler() = default;
+  ~ParserProfiler() = default;
+  ThreadBuffer *GetThreadBuffer();
+
+  std::atomic<bool> enabled_{false};
+  // bumped by Start, buffers of earlier sessions are replaced on their next use
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<uint64_t> span_count_{0};
+  std::mutex mutex_;
+  std::string output_file_;
+  uint64_t start_us_ = 0;
+  int64_t start_peak_rss_kb_ = -1;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+///
+/// @ingroup domi_omg
+/// @brief Records a span from construction to destruction when profiling is enabled
+///
+class ParserProfileScope {
+ public:
+  explicit ParserProfileScope(const char *name);
+  ~ParserProfileScope();
+  ParserProfileScope(const ParserProfileScope &) = delete;
+  ParserProfileScope &operator=(const ParserProfileScope &) = delete;
+
+  // The parse of a single node reports its op type once known
+  void SetOpType(const std::string &op_type) {
+    if (start_us_ != 0) {
+      op_type_ = op_type;
+    }
+  }
+
+ private:
+  const char *name_;
+  std::string op_type_;
+  uint64_t start_us_;
+};
+
+///
+/// @ingroup domi_omg
+/// @brief Profiles and traces the scope it lives in as one conversion, Finish on every return path
+///
+class ParserProfileSession {
+ public:
+  explicit ParserProfileSession(const std::map<AscendString, AscendString> &parser_params) {
+    ParserProfiler::Instance().Start(parser_params);
+    ParserTrace::Instance().Start(parser_params);
+  }
+  ~ParserProfileSession() {
+    ParserTrace::Instance().Finish();
+    (void)ParserProfiler::Instance().Finish();
+  }
+  ParserProfileSession(const ParserProfileSession &) = delete;
+  ParserProfileSession &operator=(const ParserProfileSession &) = delete;
+};
+}  // namespace parser
+}  // namespace ge
+
+#define PARSER_PROFILE_SCOPE(name) ge::parser::ParserProfileScope parser_profile_scope(name)
+
+#endif  // PARSER_COMMON_PARSER_PROFILER_H_
@@ -61,6 +61,65 @@ Status ParserUtils::ExpandOneToManyGraph(Graph &graph) {
   return SUCCESS;
 }
 
+Status ParserUtils::CopyComputeGraph(const ComputeGraphPtr &src, const ComputeGraphPtr &dst) {
+  GE_CHECK_NOTNULL(src);
+  GE_CHECK_NOTNULL(dst);
+  std::unordered_map<const Node *, NodePtr> old_to_new;
+  for (const auto &node : src->GetDirectNode()) {
+    GE_CHECK_NOTNULL(node);
+    OpDescPtr op_desc = AttrUtils::CloneOpDesc(node->GetOpDesc());
+    if (op_desc == nullptr) {
+      GELOGE(FAILED, "Copy op %s of graph %s failed.", node->GetName().c_str(), src->GetName().c_str());
+      return FAILED;
+    }
+    // The subgraph instances are attached to the copied node later, only their names are copied here
+    const auto &src_op_desc = node->GetOpDesc();
+    for (const auto &name_to_index : src_op_desc->GetSubgraphNameIndexes()) {
+      if (op_desc->GetSubgraphNameIndexes().count(name_to_index.first) == 0) {
+        (void)op_desc->AddSubgraphName(name_to_index.first);
+      }
+      (void)op_desc->SetSubgraphInstanceName(name_to_index.second,
+                                             src_op_desc->GetSubgraphInstanceName(name_to_index.second));
+    }
+    NodePtr new_node = dst->AddNode(op_desc);
+    GE_CHECK_NOTNULL(new_node);
+    old_to_new[node.get()] = new_node;
+  }
+
+  for (const auto &node : src->GetDirectNode()) {
+    const NodePtr &new_node = old_to_new[node.get()];
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      for (const auto &peer_in_anchor : out_anchor->GetPeerInDataAnchors()) {
+        auto iter = old_to_new.find(peer_in_anchor->GetOwnerNode().get());
+        if (iter == old_to_new.end()) {
+          continue;
+        }
+        if (GraphUtils::AddEdge(new_node->GetOutDataAnchor(out_anchor->GetIdx()),
+                                iter->second->GetInDataAnchor(peer_in_anchor->GetIdx())) != GRAPH_SUCCESS) {
+          GELOGE(FAILED, "Copy data edge from %s to %s failed.", node->GetName().c_str(),
+                 iter->second->GetName().c_str());
+          return FAILED;
+        }
+      }
+    }
+    if (node->GetOutControlAnchor() == nullptr) {
+      continue;
+    }
+    for (const auto &peer_in_anchor : node->GetOutControlAnchor()->GetPeerInControlAnchors()) {
+      auto iter = old_to_new.find(peer_in_anchor->GetOwnerNode().get());
+      if (iter == old_to_new.end()) {
+        continue;
+      }
+      if (GraphUtils::AddEdge(new_node->GetOutControlAnchor(), iter->second->GetInControlAnchor()) != GRAPH_SUCCESS) {
+        GELOGE(FAILED, "Copy control edge from %s to %s failed.", node->GetName().c_str(),
+               iter->second->GetName().c_str());
+        return FAILED;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
 Status ParserUtils::ExpandNodeToSubgraph(const Graph &subgraph, const NodePtr &node, Graph &graph) {
   ComputeGraphPtr sub_compute_graph = GraphUtils::GetComputeGraph(subgraph);
   GE_CHECK_NOTNULL(sub_compute_graph);
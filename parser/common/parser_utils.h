@@ -26,6 +26,15 @@ class ParserUtils {
  public:
   static Status ExpandOneToManyGraph(Graph &graph);
 
+  ///
+  /// @ingroup domi_omg
+  /// @brief Fill the empty graph dst with copies of the nodes and edges of src, node names are kept
+  /// @param [in] src graph to copy
+  /// @param [out] dst empty graph, its name and owner node are kept
+  /// @return SUCCESS copy successfully
+  ///
+  static Status CopyComputeGraph(const ComputeGraphPtr &src, const ComputeGraphPtr &dst);
+
  private:
   static Status ExpandNodeToSubgraph(const Graph &subgraph, const NodePtr &node, Graph &graph);
   static Status HandleInputContext(const NodePtr &node,
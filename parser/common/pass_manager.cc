@@ -15,29 +15,81 @@
  */
 
 #include "parser/common/pass_manager.h"
+#include <algorithm>
+#include <future>
 #include "framework/omg/parser/parser_types.h"
 #include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/parser_profiler.h"
+#include "parser/common/thread_pool.h"
 #include "common/debug/log.h"
 #include "graph/utils/node_utils.h"
 #include "omg/omg_inner_types.h"
 
 namespace ge {
 namespace parser {
+namespace {
+const uint32_t kThreadNum = 16;
+const size_t kMinSubgraphsPerTask = 2;
+
+Status RunPassOnGraph(const std::string &pass_name, GraphPass *pass, const ComputeGraphPtr &graph,
+                      PassRunRecord &record) {
+  uint64_t start_us = GetCurrentTimestamp();
+  record.status = pass->Run(graph);
+  uint64_t end_us = GetCurrentTimestamp();
+  record.pass_name = pass_name;
+  record.graph_name = graph->GetName();
+  record.cost_us = end_us - start_us;
+  if (ParserProfiler::Instance().IsEnabled()) {
+    ParserProfiler::Instance().AddSpan(pass_name + "::" + record.graph_name, start_us, end_us);
+  }
+  return record.status;
+}
+
+void LogPassCost(const vector<PassRunRecord> &run_records, size_t first_record, uint64_t wall_us) {
+  if (!PARSER_LOG_ENABLED(DLOG_INFO) || first_record >= run_records.size()) {
+    return;
+  }
+  uint64_t total_us = 0;
+  const PassRunRecord *slowest = &run_records[first_record];
+  for (size_t i = first_record; i < run_records.size(); ++i) {
+    total_us += run_records[i].cost_us;
+    if (run_records[i].cost_us > slowest->cost_us) {
+      slowest = &run_records[i];
+    }
+  }
+  GELOGI("[GEPERFTRACE] Pass %s ran on %zu graphs in %lu micro second, sum of graphs %lu, slowest %s %lu.",
+         slowest->pass_name.c_str(), run_records.size() - first_record, wall_us, total_us,
+         slowest->graph_name.c_str(), slowest->cost_us);
+}
+}  // namespace
+
 const vector<std::pair<std::string, GraphPass *>> &PassManager::GraphPasses() const { return names_to_graph_passes_; }
 
-Status PassManager::AddPass(const string &pass_name, GraphPass *pass) {
+Status PassManager::AddPass(const string &pass_name, GraphPass *pass, bool subgraph_local) {
   GE_CHECK_NOTNULL(pass);
   names_to_graph_passes_.emplace_back(pass_name, pass);
+  if (subgraph_local) {
+    (void)subgraph_local_passes_.insert(pass);
+  }
   return SUCCESS;
 }
 
 Status PassManager::Run(const ComputeGraphPtr &graph) {
   GE_CHECK_NOTNULL(graph);
-  return Run(graph, names_to_graph_passes_);
+  run_records_.clear();
+  return RunPasses(graph, names_to_graph_passes_, subgraph_local_passes_, run_records_);
 }
 
 Status PassManager::Run(const ComputeGraphPtr &graph, vector<std::pair<std::string, GraphPass *>> &names_to_passes) {
   GE_CHECK_NOTNULL(graph);
+  vector<PassRunRecord> run_records;
+  return RunPasses(graph, names_to_passes, std::set<const GraphPass *>(), run_records);
+}
+
+Status PassManager::RunPasses(const ComputeGraphPtr &graph,
+                              vector<std::pair<std::string, GraphPass *>> &names_to_passes,
+                              const std::set<const GraphPass *> &subgraph_local_passes,
+                              vector<PassRunRecord> &run_records) {
   bool not_changed = true;
 
   for (auto &pass_pair : names_to_passes) {
@@ -45,31 +97,84 @@ Status PassManager::Run(const ComputeGraphPtr &graph, vector<std::pair<std::stri
     const auto &pass_name = pass_pair.first;
     GE_CHECK_NOTNULL(pass);
 
-    PARSER_TIMESTAMP_START(PassRun);
-    Status status = pass->Run(graph);
+    uint64_t start_us = GetCurrentTimestamp();
+    size_t first_record = run_records.size();
+    run_records.emplace_back();
+    Status status = RunPassOnGraph(pass_name, pass, graph, run_records.back());
     if (status == SUCCESS) {
       not_changed = false;
     } else if (status != NOT_CHANGED) {
       GELOGE(status, "Pass Run failed on graph %s", graph->GetName().c_str());
       return status;
     }
-    for (const auto &subgraph :graph->GetAllSubgraphs()) {
+    auto subgraphs = graph->GetAllSubgraphs();
+    for (const auto &subgraph : subgraphs) {
       GE_CHECK_NOTNULL(subgraph);
-      GE_CHK_STATUS_RET(pass->ClearStatus(), "pass clear status failed for subgraph %s", subgraph->GetName().c_str());
-      string subgraph_pass_name = pass_name + "::" + graph->GetName();
-      PARSER_TIMESTAMP_START(PassRunSubgraph);
-      status = pass->Run(subgraph);
-      PARSER_TIMESTAMP_END(PassRunSubgraph, subgraph_pass_name.c_str());
-      if (status == SUCCESS) {
-        not_changed = false;
-      } else if (status != NOT_CHANGED) {
-        GELOGE(status, "Pass Run failed on subgraph %s", subgraph->GetName().c_str());
-        return status;
+    }
+    bool parallel = (subgraph_local_passes.count(pass) > 0) && (subgraphs.size() > 1);
+    status = RunOnSubgraphs(pass_name, pass, subgraphs, parallel, run_records);
+    if (status == SUCCESS) {
+      not_changed = false;
+    } else if (status != NOT_CHANGED) {
+      return status;
+    }
+    LogPassCost(run_records, first_record, GetCurrentTimestamp() - start_us);
+  }
+
+  return not_changed ? NOT_CHANGED : SUCCESS;
+}
+
+Status PassManager::RunOnSubgraphs(const std::string &pass_name, GraphPass *pass,
+                                   const vector<ComputeGraphPtr> &subgraphs, bool parallel,
+                                   vector<PassRunRecord> &run_records) {
+  vector<PassRunRecord> subgraph_records(subgraphs.size());
+  if (!parallel) {
+    for (size_t i = 0; i < subgraphs.size(); ++i) {
+      GE_CHK_STATUS_RET(pass->ClearStatus(), "pass clear status failed for subgraph %s",
+                        subgraphs[i]->GetName().c_str());
+      (void)RunPassOnGraph(pass_name, pass, subgraphs[i], subgraph_records[i]);
+      if ((subgraph_records[i].status != SUCCESS) && (subgraph_records[i].status != NOT_CHANGED)) {
+        subgraph_records.resize(i + 1);
+        break;
       }
     }
-    PARSER_TIMESTAMP_END(PassRun, pass_name.c_str());
+  } else {
+    // A subgraph local pass keeps no state between runs, clearing it once covers every subgraph
+    GE_CHK_STATUS_RET(pass->ClearStatus(), "pass clear status failed for subgraphs");
+    auto run_range = [&pass_name, pass, &subgraphs, &subgraph_records](size_t begin, size_t end) -> Status {
+      for (size_t i = begin; i < end; ++i) {
+        (void)RunPassOnGraph(pass_name, pass, subgraphs[i], subgraph_records[i]);
+      }
+      return SUCCESS;
+    };
+    size_t task_num = std::min(static_cast<size_t>(kThreadNum),
+                               (subgraphs.size() + kMinSubgraphsPerTask - 1) / kMinSubgraphsPerTask);
+    ThreadPool executor(static_cast<uint32_t>(task_num));
+    std::vector<std::future<Status>> futures;
+    size_t range_size = (subgraphs.size() + task_num - 1) / task_num;
+    for (size_t begin = 0; begin < subgraphs.size(); begin += range_size) {
+      std::future<Status> f = executor.commit(run_range, begin, std::min(begin + range_size, subgraphs.size()));
+      if (!f.valid()) {
+        GELOGE(FAILED, "Future is invalid");
+        return FAILED;
+      }
+      futures.push_back(std::move(f));
+    }
+    for (auto &f : futures) {
+      (void)f.get();
+    }
   }
 
+  bool not_changed = true;
+  for (const auto &record : subgraph_records) {
+    run_records.push_back(record);
+    if (record.status == SUCCESS) {
+      not_changed = false;
+    } else if (record.status != NOT_CHANGED) {
+      GELOGE(record.status, "Pass Run failed on subgraph %s", record.graph_name.c_str());
+      return record.status;
+    }
+  }
   return not_changed ? NOT_CHANGED : SUCCESS;
 }
 
@@ -17,6 +17,8 @@
 #ifndef PARSER_COMMON_PASS_MANAGER_H_
 #define PARSER_COMMON_PASS_MANAGER_H_
 
+#include <set>
+#include <string>
 #include <vector>
 
 #include "inc/graph_pass.h"
@@ -25,6 +27,17 @@ using std::vector;
 
 namespace ge {
 namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Cost of one pass run on one graph
+///
+struct PassRunRecord {
+  std::string pass_name;
+  std::string graph_name;
+  uint64_t cost_us = 0;
+  Status status = SUCCESS;
+};
+
 ///
 /// @ingroup domi_omg
 /// @brief pass manager
@@ -41,9 +54,11 @@ public:
   ///
   /// Add graph pass
   /// @param [in] pass  Pass to be added, it will be destroyed when pass manager destroys.
+  /// @param [in] subgraph_local  The pass only changes the graph it runs on and keeps no state between runs,
+  ///                             so it may run on all subgraphs of the root graph at the same time.
   /// @author
   ///
-  Status AddPass(const string &pass_name, GraphPass *pass);
+  Status AddPass(const string &pass_name, GraphPass *pass, bool subgraph_local = false);
 
   ///
   /// Optimize graph with added pass
@@ -66,10 +81,26 @@ public:
   ///
   static Status Run(const ge::ComputeGraphPtr &graph, vector<std::pair<std::string, GraphPass *>> &passes);
 
+  ///
+  /// Cost of every pass on the root graph and each subgraph in the last Run, in run order
+  /// @author
+  ///
+  const vector<PassRunRecord> &RunRecords() const { return run_records_; }
+
   ~PassManager();
 
 private:
+  static Status RunPasses(const ge::ComputeGraphPtr &graph, vector<std::pair<std::string, GraphPass *>> &passes,
+                          const std::set<const GraphPass *> &subgraph_local_passes,
+                          vector<PassRunRecord> &run_records);
+
+  static Status RunOnSubgraphs(const std::string &pass_name, GraphPass *pass,
+                               const vector<ge::ComputeGraphPtr> &subgraphs, bool parallel,
+                               vector<PassRunRecord> &run_records);
+
   vector<std::pair<std::string, GraphPass *>> names_to_graph_passes_;
+  std::set<const GraphPass *> subgraph_local_passes_;
+  vector<PassRunRecord> run_records_;
 };
 }  // namespace parser
 }  // namespace ge
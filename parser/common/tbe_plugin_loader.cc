@@ -20,11 +20,15 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <set>
+#include <sstream>
 #include <string>
 
 #include "common/util/error_manager/error_manager.h"
@@ -33,12 +37,20 @@
 #include "framework/omg/parser/parser_inner_ctx.h"
 #include "graph/utils/type_utils.h"
 #include "parser/common/acl_graph_parser_util.h"
+#include "register/op_registry.h"
 
 namespace ge {
 std::map<string, string> TBEPluginLoader::options_ = {};
 
 namespace {
 const std::string FRAMEWORK_TYPE = "ge.frameworkType";
+// Bump when the manifest layout changes, manifests of other versions are rebuilt
+const char *const kPluginManifestHeader = "parser_plugin_manifest 2";
+const char *const kPluginManifestName = "parser_plugin_manifest";
+const char kManifestFieldSep = '\t';
+const char kManifestTypeSep = ',';
+// Depth of the PluginRegistryReadScope objects holding registry_lock_ on this thread
+thread_local uint32_t registry_read_depth = 0;
 }
 
 // Get Singleton Instance
@@ -48,6 +60,11 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TBEPluginLoader &TBEPluginLoade
 }
 
 Status TBEPluginLoader::ClearHandles_() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  plugin_files_.clear();
+  deferred_plugins_.clear();
+  has_deferred_ = false;
+  finalize_fn_ = nullptr;
   Status ret = SUCCESS;
   for (const auto &handle : handles_vec_) {
     if (dlclose(handle) != 0) {
@@ -84,21 +101,321 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void TBEPluginLoader::LoadPlugi
 
   GELOGW("The shared library will not be checked. Please ensure that the source of the shared library is trusted.");
 
+  string manifest_file = GetManifestFile();
+  std::map<string, PluginManifestEntry> manifest;
+  bool manifest_changed = !manifest_file.empty() && !ReadManifest(manifest_file, manifest);
+  std::map<string, PluginManifestEntry> new_manifest;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  defer_loading_ = !manifest_file.empty();
+  plugin_files_ = file_list;
+  deferred_plugins_.clear();
   // Load other so files except lib_caffe_parser.so in the plugin so path
   for (auto elem : file_list) {
     StringUtils::Trim(elem);
 
-    void *handle = dlopen(elem.c_str(), RTLD_NOW | RTLD_GLOBAL | RTLD_NODELETE);
-    if (handle == nullptr) {
-      GELOGW("dlopen failed, plugin name:%s. Message(%s).", elem.c_str(), dlerror());
-    } else if (find(handles_vec_.begin(), handles_vec_.end(), handle) == handles_vec_.end()) {
-      // Close dl when the program exist, not close here
-      GELOGI("Plugin load %s success.", elem.c_str());
-      handles_vec_.push_back(handle);
+    PluginManifestEntry entry;
+    if (manifest_file.empty() || !GetPluginStat(elem, entry)) {
+      (void)LoadPlugin(elem, entry.op_types);
+      continue;
+    }
+    auto it = manifest.find(elem);
+    bool unchanged = (it != manifest.end()) && (it->second.size == entry.size) && (it->second.mtime == entry.mtime);
+    if (unchanged && !it->second.op_types.empty()) {
+      GELOGD("Plugin %s is loaded when one of its %zu op types is met.", elem.c_str(), it->second.op_types.size());
+      entry.op_types = it->second.op_types;
+      for (const auto &op_type : entry.op_types) {
+        deferred_plugins_[op_type].push_back(elem);
+      }
+    } else if (!LoadPlugin(elem, entry.op_types)) {
+      // Nothing was registered by this load, keep what an earlier manifest knows or leave the plugin out
+      if (unchanged) {
+        entry.op_types = it->second.op_types;
+      } else {
+        manifest_changed = true;
+        continue;
+      }
     } else {
-      GELOGI("Plugin so has already been loaded, no need to load again.");
+      manifest_changed = true;
+    }
+    new_manifest[elem] = entry;
+  }
+  has_deferred_ = !deferred_plugins_.empty();
+
+  if (manifest_changed || (manifest.size() != new_manifest.size())) {
+    SaveManifest(manifest_file, new_manifest);
+  }
+}
+
+bool TBEPluginLoader::LoadPlugin(const string &so_path, vector<string> &op_types) {
+  op_types.clear();
+  // A plugin already in the process, kept by RTLD_NODELETE from an earlier initialize, registers nothing now
+  void *loaded_handle = dlopen(so_path.c_str(), RTLD_NOW | RTLD_NOLOAD);
+  if (loaded_handle != nullptr) {
+    (void)dlclose(loaded_handle);
+  }
+  auto &registration_datas = domi::OpRegistry::Instance()->registrationDatas;
+  size_t begin = registration_datas.size();
+  size_t scope_pass_begin = (scope_pass_counter_ != nullptr) ? scope_pass_counter_() : 0;
+  // With the plugin manifest the op types a plugin registers are only learnt from loading it, keep it in the
+  // process so that a later initialize does not register it a second time
+  int flags = defer_loading_ ? (RTLD_NOW | RTLD_GLOBAL | RTLD_NODELETE) : (RTLD_NOW | RTLD_GLOBAL);
+  void *handle = dlopen(so_path.c_str(), flags);
+  if (handle == nullptr) {
+    GELOGW("dlopen failed, plugin name:%s. Message(%s).", so_path.c_str(), dlerror());
+    return false;
+  } else if (find(handles_vec_.begin(), handles_vec_.end(), handle) == handles_vec_.end()) {
+    // Close dl when the program exist, not close here
+    GELOGI("Plugin load %s success.", so_path.c_str());
+    handles_vec_.push_back(handle);
+  } else {
+    GELOGI("Plugin so has already been loaded, no need to load again.");
+  }
+  if (loaded_handle != nullptr) {
+    return false;
+  }
+
+  // Scope fusion passes run before any op type is looked at, keep such plugins loaded eagerly
+  if ((scope_pass_counter_ != nullptr) && (scope_pass_counter_() != scope_pass_begin)) {
+    GELOGI("Plugin %s registers scope fusion passes, it is loaded at initialize.", so_path.c_str());
+    return true;
+  }
+  // Registrations the parser only finds by om type, such as fusion op parsers, keep the plugin loaded eagerly
+  for (size_t i = begin; i < registration_datas.size(); ++i) {
+    const OpRegistrationData &reg_data = registration_datas[i];
+    std::set<string> ori_op_types = reg_data.GetOriginOpTypeSet();
+    if (ori_op_types.empty() || (reg_data.GetFusionParseParamFn() != nullptr) ||
+        (reg_data.GetFusionParseParamByOpFn() != nullptr)) {
+      op_types.clear();
+      return true;
+    }
+    for (const auto &op_type : ori_op_types) {
+      if (op_type.empty() || (op_type.find_first_of("\t\n,") != string::npos)) {
+        op_types.clear();
+        return true;
+      }
+      op_types.push_back(op_type);
+    }
+  }
+  return true;
+}
+
+void TBEPluginLoader::FinalizeRegistrations(const RegistrationFinalizeFn &fn) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  finalize_fn_ = fn;
+  FinalizeFrom(0);
+}
+
+void TBEPluginLoader::FinalizeFrom(size_t begin) {
+  if (finalize_fn_ == nullptr) {
+    return;
+  }
+  // Finalizing never adds registration datas, the vector is walked in place instead of copied
+  const auto &registration_datas = domi::OpRegistry::Instance()->registrationDatas;
+  size_t end = registration_datas.size();
+  GELOGI("The size of registrationDatas in parser is: %zu, finalize from %zu", end, begin);
+  for (size_t i = begin; i < end; ++i) {
+    finalize_fn_(registration_datas[i]);
+  }
+}
+
+bool TBEPluginLoader::LoadPluginOfOpType(const std::string &ori_op_type) {
+  if (!has_deferred_) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deferred_plugins_.find(ori_op_type) == deferred_plugins_.end()) {
+      return false;
+    }
+  }
+  bool loaded = false;
+  RegisterExclusively([this, &ori_op_type, &loaded]() {
+    // Another parse may have loaded the plugins while this one waited for the lock
+    auto it = deferred_plugins_.find(ori_op_type);
+    if (it == deferred_plugins_.end()) {
+      return;
+    }
+    vector<string> so_paths = it->second;
+    size_t begin = domi::OpRegistry::Instance()->registrationDatas.size();
+    for (const auto &so_path : so_paths) {
+      GELOGI("Load plugin %s for op type %s.", so_path.c_str(), ori_op_type.c_str());
+      vector<string> op_types;
+      (void)LoadPlugin(so_path, op_types);
     }
+    // Every op type of the loaded plugins is resolved now
+    for (auto iter = deferred_plugins_.begin(); iter != deferred_plugins_.end();) {
+      auto &paths = iter->second;
+      for (const auto &so_path : so_paths) {
+        paths.erase(std::remove(paths.begin(), paths.end(), so_path), paths.end());
+      }
+      iter = paths.empty() ? deferred_plugins_.erase(iter) : std::next(iter);
+    }
+    has_deferred_ = !deferred_plugins_.empty();
+    FinalizeFrom(begin);
+    loaded = true;
+  });
+  return loaded;
+}
+
+void TBEPluginLoader::LoadAllPlugins() {
+  if (!has_deferred_) {
+    return;
+  }
+  RegisterExclusively([this]() {
+    vector<string> so_paths;
+    for (const auto &deferred : deferred_plugins_) {
+      for (const auto &so_path : deferred.second) {
+        if (find(so_paths.begin(), so_paths.end(), so_path) == so_paths.end()) {
+          so_paths.push_back(so_path);
+        }
+      }
+    }
+    deferred_plugins_.clear();
+    has_deferred_ = false;
+    size_t begin = domi::OpRegistry::Instance()->registrationDatas.size();
+    for (const auto &so_path : so_paths) {
+      vector<string> op_types;
+      (void)LoadPlugin(so_path, op_types);
+    }
+    FinalizeFrom(begin);
+  });
+}
+
+void TBEPluginLoader::RegisterExclusively(const std::function<void()> &load) {
+  // Deferred loads happen in the serial passes over the model, before the parse reads the registries, so the
+  // calling thread can leave its read lock here without holding anything looked up under it
+  bool reading = registry_read_depth > 0;
+  if (reading) {
+    (void)pthread_rwlock_unlock(&registry_lock_);
+  }
+  (void)pthread_rwlock_wrlock(&registry_lock_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load();
+  }
+  (void)pthread_rwlock_unlock(&registry_lock_);
+  if (reading) {
+    (void)pthread_rwlock_rdlock(&registry_lock_);
+  }
+}
+
+vector<string> TBEPluginLoader::GetPluginFiles() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return plugin_files_;
+}
+
+void TBEPluginLoader::SetScopePassCounter(const ScopePassCountFn &fn) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  scope_pass_counter_ = fn;
+}
+
+PluginRegistryReadScope::PluginRegistryReadScope() {
+  TBEPluginLoader &loader = TBEPluginLoader::Instance();
+  if (!loader.defer_loading_) {
+    return;
+  }
+  if (registry_read_depth == 0) {
+    (void)pthread_rwlock_rdlock(&loader.registry_lock_);
+  }
+  ++registry_read_depth;
+  locked_ = true;
+}
+
+PluginRegistryReadScope::~PluginRegistryReadScope() {
+  if (!locked_) {
+    return;
+  }
+  if (--registry_read_depth == 0) {
+    (void)pthread_rwlock_unlock(&TBEPluginLoader::Instance().registry_lock_);
+  }
+}
+
+string TBEPluginLoader::GetManifestFile() {
+  auto it = options_.find(ge::parser::PLUGIN_MANIFEST_DIR);
+  if ((it == options_.end()) || it->second.empty()) {
+    return "";
+  }
+  const string &manifest_dir = it->second;
+  if ((access(manifest_dir.c_str(), F_OK) != 0) && (mkdir(manifest_dir.c_str(), S_IRUSR | S_IWUSR | S_IXUSR) != 0)) {
+    GELOGW("Create plugin manifest dir %s failed, plugins are loaded at initialize.", manifest_dir.c_str());
+    return "";
+  }
+  string real_dir = ge::parser::RealPath(manifest_dir.c_str());
+  if (real_dir.empty()) {
+    GELOGW("Plugin manifest dir %s is not valid, plugins are loaded at initialize.", manifest_dir.c_str());
+    return "";
+  }
+  return real_dir + "/" + kPluginManifestName;
+}
+
+bool TBEPluginLoader::GetPluginStat(const string &so_path, PluginManifestEntry &entry) {
+  struct stat stat_buf;
+  if (stat(so_path.c_str(), &stat_buf) != 0) {
+    return false;
+  }
+  entry.size = static_cast<int64_t>(stat_buf.st_size);
+  entry.mtime = static_cast<int64_t>(stat_buf.st_mtim.tv_sec) * 1000000000 + stat_buf.st_mtim.tv_nsec;
+  return true;
+}
+
+bool TBEPluginLoader::ReadManifest(const string &manifest_file, std::map<string, PluginManifestEntry> &manifest) {
+  std::ifstream fs(manifest_file, std::ifstream::in);
+  if (!fs.is_open()) {
+    GELOGI("Plugin manifest %s does not exist yet.", manifest_file.c_str());
+    return false;
+  }
+  string line;
+  if (!std::getline(fs, line) || (line != kPluginManifestHeader)) {
+    GELOGW("Plugin manifest %s is of another version, rebuild it.", manifest_file.c_str());
+    return false;
+  }
+  // One plugin per line: path, size, mtime and the comma separated op types
+  while (std::getline(fs, line)) {
+    vector<string> fields = StringUtils::Split(line, kManifestFieldSep);
+    if (fields.size() != 4) {
+      GELOGW("Plugin manifest %s is broken, rebuild it.", manifest_file.c_str());
+      manifest.clear();
+      return false;
+    }
+    PluginManifestEntry entry;
+    entry.size = std::strtoll(fields[1].c_str(), nullptr, 10);
+    entry.mtime = std::strtoll(fields[2].c_str(), nullptr, 10);
+    if (!fields[3].empty()) {
+      entry.op_types = StringUtils::Split(fields[3], kManifestTypeSep);
+    }
+    manifest[fields[0]] = entry;
+  }
+  return true;
+}
+
+void TBEPluginLoader::SaveManifest(const string &manifest_file,
+                                   const std::map<string, PluginManifestEntry> &manifest) {
+  std::ostringstream content;
+  content << kPluginManifestHeader << "\n";
+  for (const auto &plugin : manifest) {
+    content << plugin.first << kManifestFieldSep << plugin.second.size << kManifestFieldSep << plugin.second.mtime
+            << kManifestFieldSep;
+    for (size_t i = 0; i < plugin.second.op_types.size(); ++i) {
+      content << ((i == 0) ? "" : ",") << plugin.second.op_types[i];
+    }
+    content << "\n";
+  }
+  // Processes initializing at the same time each write their own file, the last rename wins
+  string tmp_file = manifest_file + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream fs(tmp_file, std::ofstream::out | std::ofstream::trunc);
+  if (!fs.is_open()) {
+    GELOGW("Open plugin manifest %s failed.", tmp_file.c_str());
+    return;
+  }
+  fs << content.str();
+  fs.close();
+  if (fs.fail() || (rename(tmp_file.c_str(), manifest_file.c_str()) != 0)) {
+    GELOGW("Save plugin manifest %s failed.", manifest_file.c_str());
+    (void)remove(tmp_file.c_str());
+    return;
   }
+  GELOGI("Save plugin manifest %s of %zu plugins.", manifest_file.c_str(), manifest.size());
 }
 
 void TBEPluginLoader::GetCustomOpPath(std::string &customop_path) {
@@ -18,10 +18,13 @@
 #define PARSER_COMMON_TBE_PLUGIN_LOADER_H_
 
 #include <dlfcn.h>
+#include <pthread.h>
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -32,6 +35,17 @@
 
 namespace ge {
 using SoHandlesVec = std::vector<void *>;
+using RegistrationFinalizeFn = std::function<void(const OpRegistrationData &)>;
+using ScopePassCountFn = std::function<size_t()>;
+
+// A plugin as recorded in the plugin manifest
+struct PluginManifestEntry {
+  int64_t size = 0;
+  int64_t mtime = 0;
+  // Original op types the plugin registers, empty if the plugin is always loaded at initialize
+  std::vector<string> op_types;
+};
+
 class TBEPluginLoader {
 public:
   Status Finalize();
@@ -39,23 +53,92 @@ public:
   // Get TBEPluginManager singleton instance
   static TBEPluginLoader& Instance();
 
+  ///
+  /// @ingroup domi_omg
+  /// @brief Load the plugins in the custom op path. With the initialize option plugin_manifest_dir, plugins
+  ///        unchanged since the manifest was written are only loaded when one of their op types is met.
+  ///
   void LoadPluginSo(const std::map<string, string> &options);
 
+  ///
+  /// @ingroup domi_omg
+  /// @brief Finalize the registration datas of the loaded plugins with fn, plugins loaded later are finalized
+  ///        by fn as they are loaded
+  ///
+  void FinalizeRegistrations(const RegistrationFinalizeFn &fn);
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Load the deferred plugins registering an original op type
+  /// @return true if a plugin was loaded
+  ///
+  bool LoadPluginOfOpType(const std::string &ori_op_type);
+
+  // Load every deferred plugin, for registrations that can not be found by op type
+  void LoadAllPlugins();
+
+  // Plugin files found by the last LoadPluginSo, loaded or deferred
+  vector<string> GetPluginFiles();
+
+  // Set by the tensorflow parser, plugins registering scope fusion passes are never deferred
+  void SetScopePassCounter(const ScopePassCountFn &fn);
+
   static string GetPath();
 
 private:
   TBEPluginLoader() = default;
   ~TBEPluginLoader() = default;
   Status ClearHandles_();
+  bool LoadPlugin(const string &so_path, vector<string> &op_types);
+  void FinalizeFrom(size_t begin);
+  static string GetManifestFile();
+  static bool GetPluginStat(const string &so_path, PluginManifestEntry &entry);
+  static bool ReadManifest(const string &manifest_file, std::map<string, PluginManifestEntry> &manifest);
+  static void SaveManifest(const string &manifest_file, const std::map<string, PluginManifestEntry> &manifest);
   static void ProcessSoFullName(vector<string> &file_list, string &caffe_parser_path, string &full_name,
                                 const string &caffe_parser_so_suff, const string &aicpu_so_suff,
                                 const string &aicpu_host_so_suff);
   static void GetCustomOpPath(std::string &customop_path);
   static void GetPluginSoFileList(const string &path, vector<string> &file_list, string &caffe_parser_path);
   static void FindParserSo(const string &path, vector<string> &file_list, string &caffe_parser_path);
+  // Run load with registry_lock_ held exclusively, a read scope of the calling thread is left meanwhile
+  void RegisterExclusively(const std::function<void()> &load);
+
+  friend class PluginRegistryReadScope;
 
   SoHandlesVec handles_vec_;
   static std::map<string, string> options_;
+
+  std::mutex mutex_;
+  // Set by LoadPluginSo when the plugin manifest defers plugins, they then register while models are parsed
+  std::atomic<bool> defer_loading_{false};
+  // Read by the parses through PluginRegistryReadScope, written by the deferred plugin loads. It is taken
+  // before mutex_ and never while mutex_ is held.
+  pthread_rwlock_t registry_lock_ = PTHREAD_RWLOCK_INITIALIZER;
+  std::atomic<bool> has_deferred_{false};
+  // Original op type to the deferred plugins registering it, in load order
+  std::map<string, vector<string>> deferred_plugins_;
+  RegistrationFinalizeFn finalize_fn_;
+  ScopePassCountFn scope_pass_counter_;
+  vector<string> plugin_files_;
+};
+
+///
+/// @ingroup domi_omg
+/// @brief Held by a parse while it reads OpRegistry, OpParserFactory and the other registries plugins fill.
+///        A plugin deferred by the plugin manifest registers into them when it is loaded, which waits until no
+///        other parse holds a scope. Only the outermost scope of a thread takes the lock, and without deferred
+///        loading no lock is taken at all.
+///
+class PluginRegistryReadScope {
+public:
+  PluginRegistryReadScope();
+  ~PluginRegistryReadScope();
+  PluginRegistryReadScope(const PluginRegistryReadScope &) = delete;
+  PluginRegistryReadScope &operator=(const PluginRegistryReadScope &) = delete;
+
+private:
+  bool locked_ = false;
 };
 }  // namespace ge
 
@@ -33,6 +33,7 @@
 #include "external/ge/ge_api_error_codes.h"
 #include "graph/types.h"
 #include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/parse_options.h"
 
 namespace ge {
 using ThreadTask = std::function<void()>;
@@ -59,9 +60,14 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ThreadPool {
       return fail_future;
     }
     std::future<retType> future = task->get_future();
+    // The task runs with the parse options of the conversion that commits it
+    ge::parser::ParseOptionsPtr options = ge::parser::GetParseOptionsPtr();
     {
       std::lock_guard<std::mutex> lock{m_lock_};
-      tasks_.emplace([task]() { (*task)(); });
+      tasks_.emplace([task, options]() {
+        ge::parser::ParseOptionsScope options_scope(options);
+        (*task)();
+      });
     }
     cond_var_.notify_one();
     GELOGD("commit run task end");
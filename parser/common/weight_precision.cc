@@ -0,0 +1,147 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "parser/common/weight_precision.h"
+
+#include "common/debug/log.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/omg/parser/parser_types.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/parser_fp16_t.h"
+
+namespace ge {
+namespace parser {
+namespace {
+// Set on the output desc of Const nodes whose weight is stored as fp16
+const char *const kAttrNameWeightPrecisionFp16 = "_weight_precision_fp16";
+const char *const kCastNameSuffix = "_weight_precision_cast";
+
+ge::OpDescPtr CreateCastOp(const std::string &name, const ge::GeTensorDesc &half_desc) {
+  ge::OpDescPtr op_desc = ge::parser::MakeShared<ge::OpDesc>(name, ge::parser::CAST);
+  if (op_desc == nullptr) {
+    return nullptr;
+  }
+  if (!(ge::AttrUtils::SetInt(op_desc, ge::CAST_ATTR_SRCT, static_cast<int64_t>(ge::DT_FLOAT16)) &&
+        ge::AttrUtils::SetInt(op_desc, ge::CAST_ATTR_DSTT, static_cast<int64_t>(ge::DT_FLOAT)) &&
+        ge::AttrUtils::SetInt(op_desc, ge::CAST_ATTR_DST_TYPE, static_cast<int64_t>(ge::DT_FLOAT)) &&
+        ge::AttrUtils::SetBool(op_desc, ge::CAST_ATTR_TRUNCATE, false))) {
+    GELOGE(FAILED, "Set attrs of cast op %s failed.", name.c_str());
+    return nullptr;
+  }
+  ge::GeTensorDesc input_desc(half_desc.GetShape(), half_desc.GetFormat(), ge::DT_FLOAT16);
+  input_desc.SetOriginShape(half_desc.GetOriginShape());
+  input_desc.SetOriginFormat(half_desc.GetOriginFormat());
+  input_desc.SetOriginDataType(ge::DT_FLOAT16);
+  ge::GeTensorDesc output_desc(half_desc.GetShape(), half_desc.GetFormat(), ge::DT_FLOAT);
+  output_desc.SetOriginShape(half_desc.GetOriginShape());
+  output_desc.SetOriginFormat(half_desc.GetOriginFormat());
+  output_desc.SetOriginDataType(ge::DT_FLOAT);
+  if ((op_desc->AddInputDesc(input_desc) != ge::GRAPH_SUCCESS) ||
+      (op_desc->AddOutputDesc(output_desc) != ge::GRAPH_SUCCESS)) {
+    GELOGE(FAILED, "Add tensor desc of cast op %s failed.", name.c_str());
+    return nullptr;
+  }
+  return op_desc;
+}
+
+bool IsConverted(const ge::OpDescPtr &op_desc) {
+  bool converted = false;
+  if (ge::AttrUtils::GetBool(op_desc->GetOutputDesc(0), kAttrNameWeightPrecisionFp16, converted) && converted) {
+    return true;
+  }
+  // The output desc of a Const may be rebuilt after its weight was parsed, the weight keeps the mark
+  ge::ConstGeTensorPtr weight = nullptr;
+  return ge::AttrUtils::GetTensor(op_desc, ge::ATTR_NAME_WEIGHTS, weight) && (weight != nullptr) &&
+         ge::AttrUtils::GetBool(weight->GetTensorDesc(), kAttrNameWeightPrecisionFp16, converted) && converted;
+}
+
+Status InsertCastAfter(const ge::NodePtr &node) {
+  ge::ComputeGraphPtr owner_graph = node->GetOwnerComputeGraph();
+  GE_CHECK_NOTNULL(owner_graph);
+  ge::OutDataAnchorPtr out_anchor = node->GetOutDataAnchor(0);
+  GE_CHECK_NOTNULL(out_anchor);
+  ge::GeTensorDescPtr half_desc = node->GetOpDesc()->MutableOutputDesc(0);
+  GE_CHECK_NOTNULL(half_desc);
+  half_desc->SetDataType(ge::DT_FLOAT16);
+  ge::OpDescPtr cast_desc = CreateCastOp(node->GetName() + kCastNameSuffix, *half_desc);
+  GE_CHECK_NOTNULL(cast_desc);
+  ge::NodePtr cast_node = owner_graph->AddNode(cast_desc);
+  GE_CHECK_NOTNULL(cast_node);
+
+  for (const ge::InDataAnchorPtr &peer_in_anchor : out_anchor->GetPeerInDataAnchors()) {
+    if ((ge::GraphUtils::RemoveEdge(out_anchor, peer_in_anchor) != ge::GRAPH_SUCCESS) ||
+        (ge::GraphUtils::AddEdge(cast_node->GetOutDataAnchor(0), peer_in_anchor) != ge::GRAPH_SUCCESS)) {
+      GELOGE(FAILED, "Move consumers of weight %s to its cast failed.", node->GetName().c_str());
+      return FAILED;
+    }
+    // Consumers expect the fp32 weight of the model
+    ge::OpDescPtr peer_desc = peer_in_anchor->GetOwnerNode()->GetOpDesc();
+    GE_CHECK_NOTNULL(peer_desc);
+    ge::GeTensorDescPtr peer_input_desc = peer_desc->MutableInputDesc(static_cast<uint32_t>(peer_in_anchor->GetIdx()));
+    if ((peer_input_desc != nullptr) && (peer_input_desc->GetDataType() == ge::DT_FLOAT16)) {
+      peer_input_desc->SetDataType(ge::DT_FLOAT);
+    }
+  }
+  if (ge::GraphUtils::AddEdge(out_anchor, cast_node->GetInDataAnchor(0)) != ge::GRAPH_SUCCESS) {
+    GELOGE(FAILED, "Link weight %s to its cast failed.", node->GetName().c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+}  // namespace
+
+bool WeightPrecision::ShouldConvert(const std::string &node_name, ge::DataType data_type, int64_t count) {
+  if (!IsEnabled() || (data_type != ge::DT_FLOAT) || (count <= 1)) {
+    return false;
+  }
+  return !IsExcluded(node_name);
+}
+
+void WeightPrecision::ToFp16(const float *data, int64_t count, std::vector<uint16_t> &half) {
+  half.resize(static_cast<size_t>(count));
+  FloatToFp16Array(data, half.data(), half.size());
+}
+
+void WeightPrecision::MarkConverted(ge::GeTensorDesc &desc) {
+  (void)ge::AttrUtils::SetBool(desc, kAttrNameWeightPrecisionFp16, true);
+}
+
+Status WeightPrecision::InsertCasts(const ge::ComputeGraphPtr &graph) {
+  GE_CHECK_NOTNULL(graph);
+  if (!IsEnabled()) {
+    return SUCCESS;
+  }
+  std::vector<ge::NodePtr> weight_nodes;
+  for (const ge::NodePtr &node : graph->GetAllNodes()) {
+    ge::OpDescPtr op_desc = node->GetOpDesc();
+    if ((op_desc == nullptr) || (op_desc->GetOutputsSize() == 0) || (node->GetOutDataNodesSize() == 0)) {
+      continue;
+    }
+    if (IsConverted(op_desc)) {
+      weight_nodes.push_back(node);
+    }
+  }
+  for (const ge::NodePtr &node : weight_nodes) {
+    GE_RETURN_IF_ERROR(InsertCastAfter(node));
+  }
+  GELOGI("Insert %zu casts behind the weights stored as fp16.", weight_nodes.size());
+  return SUCCESS;
+}
+}  // namespace parser
+}  // namespace ge
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PARSER_COMMON_WEIGHT_PRECISION_H_
+#define PARSER_COMMON_WEIGHT_PRECISION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "external/graph/types.h"
+#include "graph/compute_graph.h"
+#include "graph/ge_tensor.h"
+#include "parser/common/parse_options.h"
+
+namespace ge {
+namespace parser {
+///
+/// @ingroup domi_omg
+/// @brief Down conversion of fp32 weights while they are materialized, enabled by the parser option
+///        weight_precision=fp16 of the current conversion (see ParseOptions). Converted weights are marked
+///        on their Const output desc, and InsertCasts puts a Cast back to fp32 behind each of them once the
+///        graph is complete, so the consumers keep seeing fp32. Only TensorFlow Const nodes and Caffe layer
+///        blobs are converted, the ONNX parser does not install the per-parse options and keeps fp32 weights.
+///
+class WeightPrecision {
+ public:
+  static bool IsEnabled() { return GetParseOptions().weight_precision != ge::DT_FLOAT; }
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Whether a weight is stored as fp16. Only fp32 weights of more than one element are,
+  ///        scalars are hyperparameters such as epsilons more often than weights.
+  /// @param [in] node_name Const node or Caffe layer the weight belongs to
+  /// @param [in] data_type type of the weight in the model
+  /// @param [in] count element count of the weight
+  ///
+  static bool ShouldConvert(const std::string &node_name, ge::DataType data_type, int64_t count);
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Convert fp32 values to fp16, rounding to nearest even and saturating like fp16_t
+  /// @param [in] data count fp32 values
+  /// @param [out] half the fp16 values
+  ///
+  static void ToFp16(const float *data, int64_t count, std::vector<uint16_t> &half);
+
+  static bool IsExcluded(const std::string &node_name) {
+    return GetParseOptions().weight_precision_exclude_nodes.count(node_name) > 0;
+  }
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Mark a weight tensor desc as converted from fp32, the Const output desc made from it is marked as well
+  ///
+  static void MarkConverted(ge::GeTensorDesc &desc);
+
+  ///
+  /// @ingroup domi_omg
+  /// @brief Insert a Cast to fp32 behind every Const with a converted weight, subgraphs included
+  /// @param [in] graph the parsed graph
+  ///
+  static Status InsertCasts(const ge::ComputeGraphPtr &graph);
+};
+}  // namespace parser
+}  // namespace ge
+
+#endif  // PARSER_COMMON_WEIGHT_PRECISION_H_
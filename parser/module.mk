@@ -66,6 +66,7 @@ endif
 PARSER_TENSORFLOW_SRC_FILES := \
     tensorflow/tensorflow_arg_parser.cc \
     tensorflow/tensorflow_auto_mapping_parser_adapter.cc \
+    tensorflow/tensorflow_auto_mapping_plan.cc \
     tensorflow/tensorflow_constant_parser.cc \
     tensorflow/tensorflow_data_parser.cc \
     tensorflow/tensorflow_enter_parser.cc \
@@ -73,11 +74,13 @@ PARSER_TENSORFLOW_SRC_FILES := \
     tensorflow/tensorflow_frameworkop_parser.cc \
     tensorflow/tensorflow_fusionop_util.cc \
     tensorflow/tensorflow_identity_parser.cc \
+    tensorflow/tensorflow_incremental_cache.cc \
     tensorflow/tensorflow_merge_parser.cc \
     tensorflow/tensorflow_no_op_parser.cc \
     tensorflow/tensorflow_parser.cc \
     tensorflow/tensorflow_ref_switch_parser.cc \
     tensorflow/tensorflow_reshape_parser.cc \
+    tensorflow/tensorflow_shape_folding.cc \
     tensorflow/tensorflow_shape_n_parser.cc \
     tensorflow/tensorflow_squeeze_parser.cc \
     tensorflow/tensorflow_var_is_initialized_op_parser.cc \
@@ -209,5 +209,5 @@ Status OnnxConstantParser::ParseParams(const Message *op_src, ge::Operator &op_d
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(ONNX, CONSTANT, OnnxConstantParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(ONNX, CONSTANT, OnnxConstantParser);
 }  // namespace ge
@@ -17,6 +17,7 @@
 #include "onnx_parser.h"
 #include <algorithm>
 #include <iostream>
+#include <unordered_set>
 #include "common/convert/pb2json.h"
 #include "common/util.h"
 #include "common/util/error_manager/error_manager.h"
@@ -32,6 +33,8 @@
 #include "parser/common/acl_graph_parser_util.h"
 #include "parser/common/model_saver.h"
 #include "parser/common/parser_utils.h"
+#include "parser/common/tbe_plugin_loader.h"
+#include "parser/common/thread_pool.h"
 #include "parser/onnx/onnx_util.h"
 #include "register/op_registry.h"
 
@@ -40,6 +43,9 @@ namespace {
 std::map<std::string, std::string> kOnnxOpMap = {
     {ge::kOpTypeInput, ge::parser::DATA}, {ge::kOpTypeConstant, ge::parser::CONSTANT},
 };
+const uint32_t kThreadNum = 16;
+// Nodes converted by one task of ParseAllNodeProto, smaller graphs are converted without the thread pool
+const size_t kMinNodesPerParseTask = 64;
 }
 
 Status OnnxModelParser::ParseInput(ge::onnx::GraphProto &onnx_graph,
@@ -214,6 +220,8 @@ Status OnnxModelParser::AdapterOpType(const ge::onnx::NodeProto *node_proto, std
     return ret;
   }
 
+  // A custom op plugin deferred by the plugin manifest registers its types when it is loaded
+  (void)TBEPluginLoader::Instance().LoadPluginOfOpType(ori_type);
   if (!domi::OpRegistry::Instance()->GetOmTypeByOriOpType(ori_type, op_type)) {
     ErrorManager::GetInstance().ATCReportErrMessage("E16002", {"optype"}, {ori_type});
     GELOGE(PARAM_INVALID, "Get omType according ori_type : %s failed.", ori_type.c_str());
@@ -235,8 +243,8 @@ Status OnnxModelParser::TransNodeToOperator(const ge::onnx::NodeProto *node_prot
     return INTERNAL_ERROR;
   }
 
-  GELOGI("After create operator, op[%s]: type[%s] have input size: %zu, output size: %zu", op.GetName().c_str(),
-         op.GetOpType().c_str(), op.GetInputsSize(), op.GetOutputsSize());
+  PARSER_LOGI("After create operator, op[%s]: type[%s] have input size: %zu, output size: %zu",
+              op.GetName().c_str(), op.GetOpType().c_str(), op.GetInputsSize(), op.GetOutputsSize());
   return SUCCESS;
 }
 
@@ -285,8 +293,9 @@ Status OnnxModelParser::SetOperatorInputs() {
         auto src_op = output_op_iter->second;
         int dst_index = input_node_index.second;
         int src_index = out_node_index.second;
-        GELOGI("Start add output:%d of op:%s as input:%d of op:%s.", src_index, src_op.GetName().c_str(), dst_index,
-               dst_op.GetName().c_str());
+        PARSER_LOGI("Start add output:%d of op:%s as input:%d of op:%s.", src_index, src_op.GetName().c_str(),
+                    dst_index, dst_op.GetName().c_str());
+        PARSER_TRACE("SetOperatorInput", input_node_index.first, src_index, dst_index);
         auto dst_op_desc = ge::OpDescUtils::GetOpDescFromOperator(dst_op);
         GE_CHECK_NOTNULL(dst_op_desc);
         auto src_op_desc = ge::OpDescUtils::GetOpDescFromOperator(src_op);
@@ -328,71 +337,112 @@ Status OnnxModelParser::Prechecker(ge::onnx::GraphProto &onnx_graph) {
   return SUCCESS;
 }
 
-void OnnxModelParser::UpdateFormat(ge::Graph &graph) {
-  std::vector<string> vec_op_name;
-  graph.GetAllOpName(vec_op_name);
+Status OnnxModelParser::UpdateFormat(const ge::OpDescPtr &op_desc) {
+  GE_CHECK_NOTNULL(op_desc);
   ge::Format format = ge::FORMAT_NCHW;
-  for (string name: vec_op_name) {
-    ge::Operator op;
-    graph.FindOpByName(name, op);
-    auto op_dsc = ge::OpDescUtils::GetOpDescFromOperator(op);
-    auto input_size = op_dsc->GetAllInputsSize();
-    for (size_t i = 0; i < input_size; i++) {
-      auto input = op_dsc->MutableInputDesc(static_cast<uint32_t>(i));
-      if (input == nullptr) {
-        continue;
-      }
-      input->SetFormat(format);
-      input->SetOriginFormat(format);
+  auto input_size = op_desc->GetAllInputsSize();
+  for (size_t i = 0; i < input_size; i++) {
+    auto input = op_desc->MutableInputDesc(static_cast<uint32_t>(i));
+    if (input == nullptr) {
+      continue;
     }
+    input->SetFormat(format);
+    input->SetOriginFormat(format);
+  }
 
-    auto output_size = op_dsc->GetOutputsSize();
-    for (size_t i = 0; i < output_size; i++) {
-      auto output = op_dsc->GetOutputDesc(i);
-      output.SetFormat(format);
-      output.SetOriginFormat(format);
-      op_dsc->UpdateOutputDesc(i, output);
+  auto output_size = op_desc->GetOutputsSize();
+  for (size_t i = 0; i < output_size; i++) {
+    auto output = op_desc->MutableOutputDesc(static_cast<uint32_t>(i));
+    if (output == nullptr) {
+      continue;
     }
+    output->SetFormat(format);
+    output->SetOriginFormat(format);
   }
+  return SUCCESS;
+}
+
+Status OnnxModelParser::ParseNodeProto(const ge::onnx::NodeProto *node_proto, const std::string &op_type,
+                                       ge::Operator &op) {
+  GE_CHECK_NOTNULL(node_proto);
+  const std::string &node_name = node_proto->name();
+  Status status = TransNodeToOperator(node_proto, op, op_type);
+  if (status != SUCCESS) {
+    GELOGE(status, "Trans node to operator for %s:%s failed.", node_name.c_str(), op_type.c_str());
+    return status;
+  }
+
+  // 7. op parser
+  std::shared_ptr<ge::OpParserFactory> factory = ge::OpParserFactory::Instance(domi::ONNX);
+  GE_CHECK_NOTNULL(factory);
+  std::shared_ptr<ge::OpParser> op_parser = factory->CreateOpParser(op_type);
+  GE_CHECK_NOTNULL(op_parser);
+  std::shared_ptr<ge::OnnxOpParser> onnx_op_parser = std::static_pointer_cast<ge::OnnxOpParser>(op_parser);
+  GE_CHECK_NOTNULL(onnx_op_parser);
+  status = onnx_op_parser->ParseParams(node_proto, op);
+  if (status != SUCCESS) {
+    GELOGE(status, "Parse params for %s:%s failed.", node_name.c_str(), op_type.c_str());
+    return status;
+  }
+  // Stamp the formats while the op desc is still private to this node. The input descs linked later by
+  // SetOperatorInputs take the formats of the stamped source outputs.
+  return UpdateFormat(ge::OpDescUtils::GetOpDescFromOperator(op));
 }
 
 Status OnnxModelParser::ParseAllNodeProto(ge::onnx::GraphProto &onnx_graph, ge::Graph &graph) {
-  for (int i = 0; i < onnx_graph.node_size(); i++) {
-    ge::onnx::NodeProto *node_proto = onnx_graph.mutable_node(i);
-    std::string node_name = node_proto->name();
+  size_t node_num = static_cast<size_t>(onnx_graph.node_size());
+  std::vector<std::string> op_types(node_num);
+  // Op type adaption records ori_to_om_type_ and may load custom op plugins, so it stays serial
+  for (size_t i = 0; i < node_num; i++) {
+    ge::onnx::NodeProto *node_proto = onnx_graph.mutable_node(static_cast<int>(i));
     std::string ori_type = node_proto->op_type();
-    GELOGI("Start parse node which name is %s, type is %s", node_name.c_str(), ori_type.c_str());
+    PARSER_LOGI("Start parse node which name is %s, type is %s", node_proto->name().c_str(), ori_type.c_str());
 
-    std::string op_type;
-    Status status = AdapterOpType(node_proto, ori_type, op_type);
+    Status status = AdapterOpType(node_proto, ori_type, op_types[i]);
     if (status != SUCCESS) {
       GELOGE(status, "Adapter op type for ori type %s failed.", ori_type.c_str());
       return status;
     }
     node_proto->set_op_type(ori_type);
+    PARSER_LOGI("Trans original type:%s to op type:%s", ori_type.c_str(), op_types[i].c_str());
+  }
 
-    GELOGI("Trans original type:%s to op type:%s", ori_type.c_str(), op_type.c_str());
-
-    ge::Operator op;
-    status = TransNodeToOperator(node_proto, op, op_type);
-    if (status != SUCCESS) {
-      GELOGE(status, "Trans node to operator for %s:%s failed.", node_name.c_str(), op_type.c_str());
-      return status;
+  // Nodes are converted independently on the pool, each task takes a range of nodes
+  std::vector<ge::Operator> ops(node_num);
+  std::vector<Status> parse_rets(node_num, SUCCESS);
+  auto parse_range = [this, &onnx_graph, &op_types, &ops, &parse_rets](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      parse_rets[i] = ParseNodeProto(&onnx_graph.node(static_cast<int>(i)), op_types[i], ops[i]);
     }
-
-    // 7. op parser
-    std::shared_ptr<ge::OpParserFactory> factory = ge::OpParserFactory::Instance(domi::ONNX);
-    GE_CHECK_NOTNULL(factory);
-    std::shared_ptr<ge::OpParser> op_parser = factory->CreateOpParser(op_type);
-    GE_CHECK_NOTNULL(op_parser);
-    std::shared_ptr<ge::OnnxOpParser> onnx_op_parser = std::static_pointer_cast<ge::OnnxOpParser>(op_parser);
-    GE_CHECK_NOTNULL(onnx_op_parser);
-    status = onnx_op_parser->ParseParams(node_proto, op);
-    if (status != SUCCESS) {
-      GELOGE(status, "Parse params for %s:%s failed.", node_name.c_str(), op_type.c_str());
-      return status;
+    return SUCCESS;
+  };
+  size_t task_num = std::min(static_cast<size_t>(kThreadNum),
+                             (node_num + kMinNodesPerParseTask - 1) / kMinNodesPerParseTask);
+  if (task_num <= 1) {
+    (void)parse_range(0, node_num);
+  } else {
+    ThreadPool executor(static_cast<uint32_t>(task_num));
+    std::vector<std::future<Status>> futures;
+    size_t range_size = (node_num + task_num - 1) / task_num;
+    for (size_t begin = 0; begin < node_num; begin += range_size) {
+      std::future<Status> f = executor.commit(parse_range, begin, std::min(begin + range_size, node_num));
+      if (!f.valid()) {
+        GELOGE(FAILED, "Future is invalid");
+        return FAILED;
+      }
+      futures.push_back(std::move(f));
+    }
+    for (auto &f : futures) {
+      (void)f.get();
     }
+  }
 
+  // Merge in node order, so the graph and the name map do not depend on the scheduling
+  for (size_t i = 0; i < node_num; i++) {
+    if (parse_rets[i] != SUCCESS) {
+      return parse_rets[i];
+    }
+    ge::Operator &op = ops[i];
     ge::graphStatus graph_status = graph.AddOp(op);
     if (graph_status != ge::GRAPH_SUCCESS) {
       GELOGE(FAILED, "Add op:%s to graph failed.", op.GetName().c_str());
@@ -401,7 +451,7 @@ Status OnnxModelParser::ParseAllNodeProto(ge::onnx::GraphProto &onnx_graph, ge::
     name_operator_[op.GetName()] = op;
 
     // 8. Construct input output relation of every node
-    status = ConstructInputOutputContext(node_proto);
+    Status status = ConstructInputOutputContext(&onnx_graph.node(static_cast<int>(i)));
     if (status != SUCCESS) {
       GELOGE(status, "Construct input output relation map failed.");
       return status;
@@ -438,10 +488,12 @@ Status OnnxModelParser::GetGraphInputsOutputs(std::vector<ge::Operator> &input_o
 }
 
 Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(file);
   GELOGI("File path is %s.", file);
 
   // 1. Get graph from onnx model file.
+  PARSER_TIMESTAMP_START(ReadModel);
   ge::onnx::ModelProto onnx_model;
   if (!ge::parser::ReadProtoFromBinaryFile(file, &onnx_model)) {
     ErrorManager::GetInstance().ATCReportErrMessage(
@@ -449,6 +501,7 @@ Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
     GELOGE(PARAM_INVALID, "Read onnx model file failed.");
     return FAILED;
   }
+  PARSER_TIMESTAMP_END(ReadModel, "OnnxModelParser::ReadModel");
   if (!onnx_model.has_graph()) {
     ErrorManager::GetInstance().ATCReportErrMessage("E16004");
     GELOGE(PARAM_INVALID, "Onnx model do not has graph.");
@@ -482,11 +535,13 @@ Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
   GELOGI("The size of initializer_name_tensor is %zu after ParseInput", initializer_name_tensor.size());
 
   // 4. Parse Constant from graph.
+  PARSER_TIMESTAMP_START(ParseInitializer);
   ret = ParseInitializer(onnx_graph, initializer_name_tensor);
   if (ret != SUCCESS) {
     GELOGE(ret, "Parse initializer for onnx failed.");
     return ret;
   }
+  PARSER_TIMESTAMP_END(ParseInitializer, "OnnxModelParser::ParseInitializer");
 
   // 5. Update node name for node do not has name.
   ret = UpdateAllNodeName(onnx_graph);
@@ -509,11 +564,13 @@ Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
   }
 
   // 7. Construct all operator and input output tensor relation.
+  PARSER_TIMESTAMP_START(ParseAllNodeProto);
   ret = ParseAllNodeProto(onnx_graph, graph);
   if (ret != SUCCESS) {
     GELOGE(ret, "Parse all node proto failed.");
     return ret;
   }
+  PARSER_TIMESTAMP_END(ParseAllNodeProto, "OnnxModelParser::ParseAllNodeProto");
 
   // 8. Parse output from graph.
   ret = ParseOutput(onnx_graph);
@@ -523,11 +580,13 @@ Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
   }
 
   // 9. Set all operator input.
+  PARSER_TIMESTAMP_START(SetOperatorInputs);
   ret = SetOperatorInputs();
   if (ret != SUCCESS) {
     GELOGE(ret, "Set operator input failed.");
     return ret;
   }
+  PARSER_TIMESTAMP_END(SetOperatorInputs, "OnnxModelParser::SetOperatorInputs");
 
   std::vector<string> op_names;
   graph.GetAllOpName(op_names);
@@ -541,11 +600,25 @@ Status OnnxModelParser::Parse(const char *file, ge::Graph &graph) {
     GELOGE(ret, "Get graph inputs and outputs failed.");
     return ret;
   }
+  PARSER_TIMESTAMP_START(SetInputsOutputs);
   graph.SetInputs(input_ops).SetOutputs(output_indexs);
+  PARSER_TIMESTAMP_END(SetInputsOutputs, "OnnxModelParser::SetInputsOutputs");
 
+  PARSER_TIMESTAMP_START(ExpandOneToManyGraph);
+  ge::ComputeGraphPtr compute_graph = ge::GraphUtils::GetComputeGraph(graph);
+  GE_CHECK_NOTNULL(compute_graph);
+  std::unordered_set<ge::NodePtr> parsed_nodes;
+  for (const auto &node : compute_graph->GetDirectNode()) {
+    (void)parsed_nodes.insert(node);
+  }
   GE_RETURN_IF_ERROR(ParserUtils::ExpandOneToManyGraph(graph));
-
-  UpdateFormat(graph);
+  // The nodes a one to many parser expands an op to are not stamped by ParseNodeProto
+  for (const auto &node : compute_graph->GetDirectNode()) {
+    if (parsed_nodes.count(node) == 0) {
+      GE_RETURN_IF_ERROR(UpdateFormat(node->GetOpDesc()));
+    }
+  }
+  PARSER_TIMESTAMP_END(ExpandOneToManyGraph, "ParserUtils::ExpandOneToManyGraph");
 
   GELOGI("Onnx model parser success.");
   return SUCCESS;
@@ -564,10 +637,7 @@ Status OnnxModelParser::ToJson(const char *model_file, const char *json_file) {
   ge::onnx::ModelProto onnx_model;
   GE_RETURN_WITH_LOG_IF_FALSE(ge::parser::ReadProtoFromBinaryFile(model_file, &onnx_model),
                               "ReadProtoFromBinaryFile failed, file:%s.", model_file);
-  ge::onnx::GraphProto graph_proto = onnx_model.graph();
-  nlohmann::json j;
-  ge::Pb2Json::Message2Json(graph_proto, std::set<std::string>(), j, true);
-  return ge::parser::ModelSaver::SaveJsonToFile(json_file, j);
+  return ge::parser::ModelSaver::SaveMessageToJsonFile(json_file, onnx_model.graph(), std::set<std::string>(), true);
 }
 
 ge::DataType OnnxModelParser::ConvertToGeDataType(const uint32_t type) {
@@ -72,6 +72,8 @@ class OnnxModelParser : public domi::ModelParser {
 
   Status TransNodeToOperator(const ge::onnx::NodeProto *node_proto, ge::Operator &op, const string &op_type);
 
+  Status ParseNodeProto(const ge::onnx::NodeProto *node_proto, const std::string &op_type, ge::Operator &op);
+
   Status ConstructInputOutputContext(const ge::onnx::NodeProto *node_proto);
 
   Status SetOperatorInputs();
@@ -81,7 +83,7 @@ class OnnxModelParser : public domi::ModelParser {
 
   Status Prechecker(ge::onnx::GraphProto &onnx_graph);
 
-  void UpdateFormat(ge::Graph &graph);
+  static Status UpdateFormat(const ge::OpDescPtr &op_desc);
 
   std::map<std::string, std::string> ori_to_om_type_;
 
@@ -15,6 +15,7 @@
  */
 
 #include "graph_functiondef.h"
+#include <atomic>
 #include <iostream>
 #include "common/fmk_error_codes.h"
 #include "graph/debug/ge_attr_define.h"
@@ -476,9 +477,9 @@ domi::Status GraphToFunctionDef::BuildFunctionDef(ge::ComputeGraphPtr &graph, co
   GE_CHECK_NOTNULL(call_node_def);
   // Current date / time base on the current system
   string now_time = ge::parser::CurrentTimeInStr();
-  static int i = 0;
-  const string name = name_in + now_time + to_string(i);
-  i++;
+  // subgraph local passes build function defs of several subgraphs at the same time
+  static std::atomic<int> i(0);
+  const string name = name_in + now_time + to_string(i.fetch_add(1));
   // set node_def
   call_node_def->set_op(name);
   call_node_def->set_name(name);
@@ -15,8 +15,10 @@
  */
 
 #include "graph_optimizer.h"
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include "./graph_insert_trans_op.h"
@@ -213,17 +215,17 @@ TBE_SET_FORMAT_DATAYPE_INFO(CCE, ge::parser::MEMCPYASYNC,
                             InDtSupportAll, OutFmtSupportAsInput, OutDtSupportAsInput)
 
 bool GetCceTbeTransInfo(string opType, OpSupportTranInfo &opSupportInfo) {
-  static bool fmtInited = false;
-  GE_IF_BOOL_EXEC(
-      !fmtInited, fmtInited = true;
-      if (domi::OpRegistry().Instance()->GetImplyType(ge::parser::DEPTHWISEWEIGHT4D26D) == domi::ImplyType::TVM) {
-        auto it = g_OpSupportTranInfo.find(string("TBE:") + ge::parser::MUL);
-        if (it != g_OpSupportTranInfo.end()) {
-          auto &fmts = it->second.inputFormats;
-          auto itFmt = std::find(fmts.begin(), fmts.end(), ge::FORMAT_NC1HWC0);
-          fmts.erase(itFmt);
-        }
-      })
+  static std::once_flag fmt_inited;
+  std::call_once(fmt_inited, []() {
+    if (domi::OpRegistry().Instance()->GetImplyType(ge::parser::DEPTHWISEWEIGHT4D26D) == domi::ImplyType::TVM) {
+      auto it = g_OpSupportTranInfo.find(string("TBE:") + ge::parser::MUL);
+      if (it != g_OpSupportTranInfo.end()) {
+        auto &fmts = it->second.inputFormats;
+        auto itFmt = std::find(fmts.begin(), fmts.end(), ge::FORMAT_NC1HWC0);
+        fmts.erase(itFmt);
+      }
+    }
+  });
   string cceTbeOpType = "TBE";
   GE_IF_BOOL_EXEC(domi::OpRegistry().Instance()->GetImplyType(opType) == domi::ImplyType::BUILDIN,
                   cceTbeOpType = "CCE";)
@@ -826,10 +828,12 @@ Status CreateNodeDefBytes(ge::NodePtr n, string originalType, map<string, PIOLis
       opDesc, ge::ATTR_NAME_FRAMEWORK_NODE_DEF,
       nodeDefBytes.CopyFrom(reinterpret_cast<const uint8_t *>(nodefStr.data()), nodefStr.length()));
 
-  // print proto
-  string nodefstr;
-  google::protobuf::TextFormat::PrintToString(proto, &nodefstr);
-  GELOGI("---> ! CreateNodeDefBytes() nodefstr : %s", nodefstr.c_str());
+  // print proto, rendering the text is costly so only when it is logged
+  if (IsLogEnable(GE_MODULE_NAME, DLOG_INFO)) {
+    string nodefstr;
+    google::protobuf::TextFormat::PrintToString(proto, &nodefstr);
+    GELOGI("---> ! CreateNodeDefBytes() nodefstr : %s", nodefstr.c_str());
+  }
   return SUCCESS;
 }
 
@@ -1175,14 +1179,17 @@ Status CreateOpDefBytes(ge::NodePtr n, string original_type) {
   (void)ge::AttrUtils::SetStr(opDesc, ge::ATTR_NAME_FRAMEWORK_OP_DEF, opdefString);
 
   // print proto
-  string opdefstr;
-  google::protobuf::TextFormat::PrintToString(proto, &opdefstr);
-  GELOGI("---> ! CreateOpDefBytes() opdefstr  :\n");
-  GELOGI("%s", opdefstr.c_str());
+  if (IsLogEnable(GE_MODULE_NAME, DLOG_INFO)) {
+    string opdefstr;
+    google::protobuf::TextFormat::PrintToString(proto, &opdefstr);
+    GELOGI("---> ! CreateOpDefBytes() opdefstr  :\n");
+    GELOGI("%s", opdefstr.c_str());
+  }
   return SUCCESS;
 }
 
-Status CreateFuncDefBytes(ge::NodePtr n, string original_type, string func_bin_path) {
+Status CreateFuncDefBytes(ge::NodePtr n, string original_type, string func_bin_path,
+                          map<string, ge::GeAttrValue::BYTES> &func_def_cache) {
   GELOGI("func_bin_path = %s", func_bin_path.c_str());
   auto opDesc = n->GetOpDesc();
 
@@ -1197,6 +1204,14 @@ Status CreateFuncDefBytes(ge::NodePtr n, string original_type, string func_bin_p
   std::string file = func_bin_path + "/" + func_string + ".bin";
   GELOGI("file = %s", file.c_str());
 
+  // Dataset nodes of one pipeline often share a function, its file is read once per parse
+  auto cache_iter = func_def_cache.find(file);
+  if (cache_iter != func_def_cache.end()) {
+    (void)ge::AttrUtils::SetBytes(opDesc, ge::ATTR_NAME_FRAMEWORK_FUNC_DEF, cache_iter->second);
+    GELOGI("funcDefBytes of %s reused, size =%zu", file.c_str(), cache_iter->second.GetSize());
+    return SUCCESS;
+  }
+
   char *buf = nullptr;
   int32_t len = 0;
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(!ge::parser::ReadBytesFromBinaryFile(file.c_str(), &buf, len), return false,
@@ -1206,20 +1221,21 @@ Status CreateFuncDefBytes(ge::NodePtr n, string original_type, string func_bin_p
 
   ge::GeAttrValue::BYTES funcDefBytes;
   funcDefBytes = ge::Buffer::CopyFrom((std::uint8_t *)buf, len);
+  delete[] buf;
   (void)ge::AttrUtils::SetBytes(opDesc, ge::ATTR_NAME_FRAMEWORK_FUNC_DEF, funcDefBytes);
   GELOGI("funcDefBytes.GetSize() =%zu", funcDefBytes.GetSize());
 
   // print proto
-  if (funcDefBytes.GetSize() > 0 && funcDefBytes.GetData() != nullptr) {
+  if (funcDefBytes.GetSize() > 0 && funcDefBytes.GetData() != nullptr && IsLogEnable(GE_MODULE_NAME, DLOG_DEBUG)) {
     domi::tensorflow::FunctionDefLibrary funcdeflib;
     (void)funcdeflib.ParseFromArray(funcDefBytes.GetData(), funcDefBytes.GetSize());
 
     string funcdeflibrarystr;
     google::protobuf::TextFormat::PrintToString(funcdeflib, &funcdeflibrarystr);
-    GELOGI("---> !CreateFuncDefBytes() funcdeflibrarystr :");
+    GELOGD("---> !CreateFuncDefBytes() funcdeflibrarystr : %s", funcdeflibrarystr.c_str());
   }
 
-  delete[] buf;
+  func_def_cache.emplace(file, funcDefBytes);
   return SUCCESS;
 }
 
@@ -1228,6 +1244,8 @@ Status ParserGraphOptimizer::MakeTfProtoDef() {
 
   map<string, PIOListHandle> mOpIOListFuncMap;
   CreateIOListFuncMap(mOpIOListFuncMap);
+  // function library bytes of this parse, keyed by .bin file
+  map<string, ge::GeAttrValue::BYTES> func_def_cache;
 
   for (ge::NodePtr n : graph_->GetDirectNode()) {
     if (n->GetType() != ge::parser::FRAMEWORKOP) continue;
@@ -1249,7 +1267,7 @@ Status ParserGraphOptimizer::MakeTfProtoDef() {
         GE_CHK_BOOL_RET_STATUS(ret == SUCCESS, ret, "Create opdefBytes failed!");
         if (original_type == "ParallelMapDataset" || original_type == "FilterDataset" ||
             original_type == "MapAndBatchDatasetV2") {
-          ret = CreateFuncDefBytes(n, original_type, GetFuncBinPath());
+          ret = CreateFuncDefBytes(n, original_type, GetFuncBinPath(), func_def_cache);
           GE_CHK_BOOL_RET_STATUS(ret == SUCCESS, ret, "Create funcdefBytes failed!");
         }
       }
@@ -1891,10 +1909,10 @@ OpDescPtr ParserGraphOptimizer::CreateTranslateOp(enum ge::Format inFormat, enum
    * 4. from NC1HWC0(FP32) to NHWC(FP32);
    * 5. from NC1HWC0(FP16) to NHWC(FP32)
    */
-  static uint32_t transop_count = 0;
+  static std::atomic<uint32_t> transop_count(0);
   OpDescPtr op_def = nullptr;
   std::stringstream sstmp;
-  sstmp << "translate_" << ge::parser::TRANSDATA << "_" << transop_count++;
+  sstmp << "translate_" << ge::parser::TRANSDATA << "_" << transop_count.fetch_add(1);
   GE_MAKE_SHARED(op_def = std::make_shared<OpDesc>(sstmp.str().c_str(), ge::parser::TRANSLATE), op_def = nullptr;
                  return op_def);
   GELOGI(
@@ -1930,10 +1948,10 @@ OpDescPtr ParserGraphOptimizer::CreateTranslateOp(enum ge::Format inFormat, enum
 }
 
 OpDescPtr ParserGraphOptimizer::CreatePermuteOp(enum ge::Format input_format, enum ge::Format output_format) {
-  static uint32_t transop_count = 0;
+  static std::atomic<uint32_t> transop_count(0);
 
   std::stringstream sstmp;
-  sstmp << "transdata_" << ge::parser::PERMUTE << "_" << transop_count++;
+  sstmp << "transdata_" << ge::parser::PERMUTE << "_" << transop_count.fetch_add(1);
 
   OpDescPtr op_desc = nullptr;
   GE_MAKE_SHARED(op_desc = std::make_shared<OpDesc>(sstmp.str().c_str(), ge::parser::PERMUTE), op_desc = nullptr;
@@ -1958,9 +1976,9 @@ OpDescPtr ParserGraphOptimizer::CreatePermuteOp(enum ge::Format input_format, en
 
 OpDescPtr ParserGraphOptimizer::CreateCastOp(enum ge::DataType input_data_type, enum ge::DataType output_data_type,
                                              enum ge::Format format) {
-  static uint32_t transop_count = 0;
+  static std::atomic<uint32_t> transop_count(0);
   std::stringstream sstmp;
-  sstmp << "transdata_" << ge::parser::CAST << "_" << transop_count++;
+  sstmp << "transdata_" << ge::parser::CAST << "_" << transop_count.fetch_add(1);
 
   OpDescPtr op_desc = nullptr;
   GE_MAKE_SHARED(op_desc = std::make_shared<OpDesc>(sstmp.str().c_str(), ge::parser::CAST), op_desc = nullptr;
@@ -1986,9 +2004,9 @@ OpDescPtr ParserGraphOptimizer::CreateCastOp(enum ge::DataType input_data_type,
   return op_desc;
 }
 OpDescPtr ParserGraphOptimizer::CreateTransDataOp(enum ge::Format input_format) {
-  static uint32_t transop_count = 0;
+  static std::atomic<uint32_t> transop_count(0);
   std::stringstream sstmp;
-  sstmp << "transdata_" << ge::parser::TRANSDATA << "_" << transop_count++;
+  sstmp << "transdata_" << ge::parser::TRANSDATA << "_" << transop_count.fetch_add(1);
 
   OpDescPtr op_desc = nullptr;
   GE_MAKE_SHARED(op_desc = std::make_shared<OpDesc>(sstmp.str().c_str(), ge::parser::TRANSDATA), op_desc = nullptr;
@@ -25,6 +25,17 @@
 namespace ge {
 shared_ptr<ScopeGraph> ScopePassManager::BuildScopeGraph(domi::tensorflow::GraphDef *graph_def) {
   GE_CHK_BOOL_EXEC(graph_def != nullptr, return nullptr, "graph_def is nullptr");
+  if (BuildEmptyScopeGraph() == nullptr) {
+    return nullptr;
+  }
+
+  auto &impl = scope_graph_->impl_;
+  impl->BuildScopeGraph(graph_def);
+
+  return scope_graph_;
+}
+
+shared_ptr<ScopeGraph> ScopePassManager::BuildEmptyScopeGraph() {
   scope_graph_ = ge::parser::MakeShared<ScopeGraph>();
   if (scope_graph_ == nullptr) {
     GELOGE(FAILED, "Scope graph make shared failed.");
@@ -33,12 +44,9 @@ shared_ptr<ScopeGraph> ScopePassManager::BuildScopeGraph(domi::tensorflow::Graph
   Status ret = scope_graph_->Init();
   if (ret != SUCCESS) {
     GELOGE(FAILED, "Scope graph init failed.");
+    scope_graph_ = nullptr;
     return nullptr;
   }
-
-  auto &impl = scope_graph_->impl_;
-  impl->BuildScopeGraph(graph_def);
-
   return scope_graph_;
 }
 
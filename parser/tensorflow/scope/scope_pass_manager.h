@@ -38,6 +38,12 @@ class ScopePassManager {
 
   shared_ptr<ScopeGraph> BuildScopeGraph(domi::tensorflow::GraphDef *graph_def);
 
+  /**
+   * @ingroup domi_omg
+   * @brief Build a scope graph without scopes, for graphs no scope fusion pass runs on
+   */
+  shared_ptr<ScopeGraph> BuildEmptyScopeGraph();
+
   domi::Status AddPass(unique_ptr<ScopeBasePass> &pass);
   domi::Status Run(shared_ptr<ScopeGraph> &graph);
 
@@ -19,7 +19,9 @@
 #include "framework/omg/parser/parser_types.h"
 #include "common/util.h"
 #include "framework/common/debug/ge_log.h"
+#include "graph/utils/attr_utils.h"
 #include "parser/common/op_parser_factory.h"
+#include "parser/tensorflow/tensorflow_auto_mapping_plan.h"
 #include "register/op_registry.h"
 #include "register/register.h"
 
@@ -46,13 +48,27 @@ Status TensorFlowAutoMappingParserAdapter::ParseParams(const Message *op_src, ge
     return PARAM_INVALID;
   }
 
-  ge::Operator op = ge::OpDescUtils::CreateOperatorFromOpDesc(op_dest);
-  Status ret = domi::AutoMappingFn(op_src, op);
-  if (ret != SUCCESS) {
-    GELOGE(FAILED, "Tensorflow auto mapping parser params failed");
-    return FAILED;
+  // Nodes of a planned (tf op, IR op) pair skip the Operator round trip of AutoMappingFn
+  const std::string plan_key = node->op() + ":" + op_dest->GetType();
+  bool plan_known = false;
+  std::shared_ptr<const TensorFlowAutoMappingPlan> plan =
+      TensorFlowAutoMappingPlanCache::Instance().GetPlan(plan_key, plan_known);
+  if ((plan != nullptr) && plan->Match(node)) {
+    GE_CHK_STATUS_RET(plan->Apply(node, op_dest), "Tensorflow auto mapping parser params failed");
+  } else {
+    ge::OpDescPtr origin_op = plan_known ? nullptr : AttrUtils::CloneOpDesc(op_dest);
+    ge::Operator op = ge::OpDescUtils::CreateOperatorFromOpDesc(op_dest);
+    Status ret = domi::AutoMappingFn(op_src, op);
+    if (ret != SUCCESS) {
+      GELOGE(FAILED, "Tensorflow auto mapping parser params failed");
+      return FAILED;
+    }
+    op.BreakConnect();
+    if (!plan_known) {
+      TensorFlowAutoMappingPlanCache::Instance().SetPlan(plan_key,
+                                                         TensorFlowAutoMappingPlan::Build(node, origin_op, op_dest));
+    }
   }
-  op.BreakConnect();
 
   // add dynamic input/output
   if (op_dest->GetType() == IDENTITYN) {
@@ -96,28 +112,28 @@ Status TensorFlowAutoMappingParserAdapter::ParseParams(const Message *op_src, ge
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, PLACEHOLDERWITHDEFAULT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, EXPANDDIMS, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, SIZE, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, SHAPE, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, GUARANTEECONST, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, BROADCASTARGS, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, PREVENTGRADIENT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, RANK, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, BROADCASTGRADIENTARGS, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, STOPGRADIENT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, DESTROYTEMPORARYVARIABLE, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, SNAPSHOT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, EMPTY, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, IDENTITYN, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, CONTROLTRIGGER, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, SWITCH, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, LOOPCOND, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, NEXTITERATION, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, REFNEXTITERATION, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, EXIT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, REFEXIT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, CONSTANT, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, PARALLELCONCATSTART, TensorFlowAutoMappingParserAdapter);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, BITCAST, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, PLACEHOLDERWITHDEFAULT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, EXPANDDIMS, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, SIZE, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, SHAPE, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, GUARANTEECONST, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, BROADCASTARGS, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, PREVENTGRADIENT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, RANK, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, BROADCASTGRADIENTARGS, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, STOPGRADIENT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, DESTROYTEMPORARYVARIABLE, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, SNAPSHOT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, EMPTY, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, IDENTITYN, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, CONTROLTRIGGER, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, SWITCH, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, LOOPCOND, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, NEXTITERATION, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, REFNEXTITERATION, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, EXIT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, REFEXIT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, CONSTANT, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, PARALLELCONCATSTART, TensorFlowAutoMappingParserAdapter);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, BITCAST, TensorFlowAutoMappingParserAdapter);
 }
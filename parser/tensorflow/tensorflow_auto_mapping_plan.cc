@@ -0,0 +1,239 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parser/tensorflow/tensorflow_auto_mapping_plan.h"
+#include "framework/common/debug/ge_log.h"
+#include "graph/utils/attr_utils.h"
+#include "parser/common/acl_graph_parser_util.h"
+#include "parser/common/op_types_without_ir.h"
+#include "register/tensor_assign.h"
+
+using domi::tensorflow::AttrValue;
+using domi::tensorflow::NodeDef;
+
+namespace ge {
+TensorFlowAutoMappingPlan::ListKind TensorFlowAutoMappingPlan::GetListKind(const AttrValue &attr_value) {
+  const AttrValue::ListValue &list = attr_value.list();
+  const int filled = static_cast<int>(list.s_size() > 0) + static_cast<int>(list.i_size() > 0) +
+                     static_cast<int>(list.f_size() > 0) + static_cast<int>(list.b_size() > 0) +
+                     static_cast<int>(list.type_size() > 0) + static_cast<int>(list.shape_size() > 0) +
+                     static_cast<int>(list.tensor_size() > 0) + static_cast<int>(list.func_size() > 0);
+  if (filled == 0) {
+    return kListEmpty;
+  }
+  if (filled > 1) {
+    return kListOther;
+  }
+  if (list.s_size() > 0) {
+    return kListS;
+  }
+  if (list.i_size() > 0) {
+    return kListI;
+  }
+  if (list.f_size() > 0) {
+    return kListF;
+  }
+  if (list.b_size() > 0) {
+    return kListB;
+  }
+  return (list.type_size() > 0) ? kListType : kListOther;
+}
+
+bool TensorFlowAutoMappingPlan::CanConvert(const AttrStep &step) {
+  if (step.ge_type == GeAttrValue::VT_NONE) {
+    return true;
+  }
+  // Shapes, tensors and functions depend on their values, they stay with AutoMappingFn
+  switch (step.value_case) {
+    case AttrValue::kS:
+      return step.ge_type == GeAttrValue::VT_STRING;
+    case AttrValue::kI:
+      return step.ge_type == GeAttrValue::VT_INT;
+    case AttrValue::kF:
+      return step.ge_type == GeAttrValue::VT_FLOAT;
+    case AttrValue::kB:
+      return step.ge_type == GeAttrValue::VT_BOOL;
+    case AttrValue::kType:
+      return step.ge_type == GeAttrValue::VT_DATA_TYPE;
+    case AttrValue::kList:
+      switch (step.list_kind) {
+        case kListEmpty:
+          return (step.ge_type == GeAttrValue::VT_LIST_STRING) || (step.ge_type == GeAttrValue::VT_LIST_INT) ||
+                 (step.ge_type == GeAttrValue::VT_LIST_FLOAT) || (step.ge_type == GeAttrValue::VT_LIST_BOOL) ||
+                 (step.ge_type == GeAttrValue::VT_LIST_DATA_TYPE);
+        case kListS:
+          return step.ge_type == GeAttrValue::VT_LIST_STRING;
+        case kListI:
+          return step.ge_type == GeAttrValue::VT_LIST_INT;
+        case kListF:
+          return step.ge_type == GeAttrValue::VT_LIST_FLOAT;
+        case kListB:
+          return step.ge_type == GeAttrValue::VT_LIST_BOOL;
+        case kListType:
+          return step.ge_type == GeAttrValue::VT_LIST_DATA_TYPE;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+
+bool TensorFlowAutoMappingPlan::ApplyStep(const AttrStep &step, const AttrValue &attr_value,
+                                          const ge::OpDescPtr &op_desc) {
+  const AttrValue::ListValue &list = attr_value.list();
+  switch (step.ge_type) {
+    case GeAttrValue::VT_NONE:
+      return true;
+    case GeAttrValue::VT_STRING:
+      return AttrUtils::SetStr(op_desc, step.name, attr_value.s());
+    case GeAttrValue::VT_INT:
+      return AttrUtils::SetInt(op_desc, step.name, attr_value.i());
+    case GeAttrValue::VT_FLOAT:
+      return AttrUtils::SetFloat(op_desc, step.name, attr_value.f());
+    case GeAttrValue::VT_BOOL:
+      return AttrUtils::SetBool(op_desc, step.name, attr_value.b());
+    case GeAttrValue::VT_DATA_TYPE:
+      return AttrUtils::SetDataType(op_desc, step.name,
+                                    domi::TensorAssign::ConvertTensorflowDataType(attr_value.type()));
+    case GeAttrValue::VT_LIST_STRING:
+      return AttrUtils::SetListStr(op_desc, step.name, std::vector<std::string>(list.s().begin(), list.s().end()));
+    case GeAttrValue::VT_LIST_INT:
+      return AttrUtils::SetListInt(op_desc, step.name, std::vector<int64_t>(list.i().begin(), list.i().end()));
+    case GeAttrValue::VT_LIST_FLOAT:
+      return AttrUtils::SetListFloat(op_desc, step.name, std::vector<float>(list.f().begin(), list.f().end()));
+    case GeAttrValue::VT_LIST_BOOL:
+      return AttrUtils::SetListBool(op_desc, step.name, std::vector<bool>(list.b().begin(), list.b().end()));
+    case GeAttrValue::VT_LIST_DATA_TYPE: {
+      std::vector<ge::DataType> types;
+      types.reserve(list.type_size());
+      for (int i = 0; i < list.type_size(); ++i) {
+        types.push_back(domi::TensorAssign::ConvertTensorflowDataType(list.type(i)));
+      }
+      return AttrUtils::SetListDataType(op_desc, step.name, types);
+    }
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<const TensorFlowAutoMappingPlan> TensorFlowAutoMappingPlan::Build(const NodeDef *node,
+                                                                                  const ge::OpDescPtr &origin_op,
+                                                                                  const ge::OpDescPtr &mapped_op) {
+  if ((node == nullptr) || (origin_op == nullptr) || (mapped_op == nullptr)) {
+    return nullptr;
+  }
+  std::shared_ptr<TensorFlowAutoMappingPlan> plan = ge::parser::MakeShared<TensorFlowAutoMappingPlan>();
+  if (plan == nullptr) {
+    return nullptr;
+  }
+
+  const std::map<std::string, GeAttrValue> origin_attrs = origin_op->GetAllAttrs();
+  const std::map<std::string, GeAttrValue> mapped_attrs = mapped_op->GetAllAttrs();
+  plan->steps_.reserve(node->attr_size());
+  for (const auto &attr : node->attr()) {
+    AttrStep step = {attr.first, attr.second.value_case(), kListNone, GeAttrValue::VT_NONE};
+    if (step.value_case == AttrValue::kList) {
+      step.list_kind = GetListKind(attr.second);
+    }
+    auto mapped_iter = mapped_attrs.find(attr.first);
+    if (mapped_iter != mapped_attrs.end()) {
+      auto origin_iter = origin_attrs.find(attr.first);
+      if ((origin_iter != origin_attrs.end()) && (origin_iter->second == mapped_iter->second)) {
+        // Can not tell an IR default AutoMappingFn kept from a value it wrote
+        GELOGD("Attr %s of node %s is ambiguous, no auto mapping plan for op %s.", attr.first.c_str(),
+               node->name().c_str(), node->op().c_str());
+        return nullptr;
+      }
+      step.ge_type = mapped_iter->second.GetValueType();
+    }
+    if (!CanConvert(step) || !ApplyStep(step, attr.second, origin_op)) {
+      GELOGD("Attr %s of node %s can not be planned, no auto mapping plan for op %s.", attr.first.c_str(),
+             node->name().c_str(), node->op().c_str());
+      return nullptr;
+    }
+    plan->steps_.push_back(step);
+  }
+
+  // The replay must give what AutoMappingFn gave, attrs and tensor descs alike
+  if ((origin_op->GetAllAttrs() != mapped_attrs) || (origin_op->GetAllInputsDesc() != mapped_op->GetAllInputsDesc()) ||
+      (origin_op->GetAllOutputsDesc() != mapped_op->GetAllOutputsDesc())) {
+    GELOGD("Replay of node %s differs from AutoMappingFn, no auto mapping plan for op %s.", node->name().c_str(),
+           node->op().c_str());
+    return nullptr;
+  }
+  GELOGD("Auto mapping plan of op %s to %s built with %zu attrs.", node->op().c_str(), mapped_op->GetType().c_str(),
+         plan->steps_.size());
+  return plan;
+}
+
+bool TensorFlowAutoMappingPlan::Match(const NodeDef *node) const {
+  if (static_cast<size_t>(node->attr_size()) != steps_.size()) {
+    return false;
+  }
+  for (const auto &step : steps_) {
+    auto iter = node->attr().find(step.name);
+    if ((iter == node->attr().end()) || (iter->second.value_case() != step.value_case)) {
+      return false;
+    }
+    if ((step.value_case == AttrValue::kList) && (GetListKind(iter->second) != step.list_kind)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status TensorFlowAutoMappingPlan::Apply(const NodeDef *node, const ge::OpDescPtr &op_desc) const {
+  for (const auto &step : steps_) {
+    auto iter = node->attr().find(step.name);
+    if ((iter == node->attr().end()) || !ApplyStep(step, iter->second, op_desc)) {
+      GELOGE(FAILED, "Set attr %s of node %s by auto mapping plan failed.", step.name.c_str(), node->name().c_str());
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+TensorFlowAutoMappingPlanCache &TensorFlowAutoMappingPlanCache::Instance() {
+  static TensorFlowAutoMappingPlanCache instance;
+  return instance;
+}
+
+void TensorFlowAutoMappingPlanCache::DropIfStale() {
+  // Plans were checked against the IR of the op types, which changes when op protos are reloaded
+  uint64_t generation = OpTypesWithoutIr::Instance().GetGeneration();
+  if (generation != generation_) {
+    plans_.clear();
+    generation_ = generation;
+  }
+}
+
+std::shared_ptr<const TensorFlowAutoMappingPlan> TensorFlowAutoMappingPlanCache::GetPlan(const std::string &key,
+                                                                                         bool &known) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DropIfStale();
+  auto iter = plans_.find(key);
+  known = (iter != plans_.end());
+  return known ? iter->second : nullptr;
+}
+
+void TensorFlowAutoMappingPlanCache::SetPlan(const std::string &key,
+                                             const std::shared_ptr<const TensorFlowAutoMappingPlan> &plan) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DropIfStale();
+  (void)plans_.emplace(key, plan);
+}
+}  // namespace ge
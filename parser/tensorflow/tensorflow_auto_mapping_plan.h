@@ -0,0 +1,115 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_TENSORFLOW_TENSORFLOW_AUTO_MAPPING_PLAN_H_
+#define PARSER_TENSORFLOW_TENSORFLOW_AUTO_MAPPING_PLAN_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/ge_attr_value.h"
+#include "graph/op_desc.h"
+#include "proto/tensorflow/node_def.pb.h"
+
+namespace ge {
+/**
+ * @ingroup domi_omg
+ * @brief Attr conversions domi::AutoMappingFn applied to one NodeDef, replayed on the OpDesc of
+ *        the following nodes of the same (tf op, IR op) pair without the ge::Operator round trip.
+ *        A plan is only built when replaying it on the first node gives exactly the attrs and
+ *        tensor descs AutoMappingFn produced, nodes whose attrs differ in name or kind from that
+ *        node still go through AutoMappingFn.
+ */
+class TensorFlowAutoMappingPlan {
+ public:
+  /**
+   * @ingroup domi_omg
+   * @brief Learn the plan of a node
+   * @param [in] node the NodeDef AutoMappingFn was run on
+   * @param [in] origin_op copy of the OpDesc before AutoMappingFn, consumed by the check
+   * @param [in] mapped_op the OpDesc after AutoMappingFn
+   * @return nullptr if the conversions can not be replayed exactly
+   */
+  static std::shared_ptr<const TensorFlowAutoMappingPlan> Build(const domi::tensorflow::NodeDef *node,
+                                                                const ge::OpDescPtr &origin_op,
+                                                                const ge::OpDescPtr &mapped_op);
+
+  /**
+   * @ingroup domi_omg
+   * @brief Whether node has the attr names and value kinds the plan was learned from
+   */
+  bool Match(const domi::tensorflow::NodeDef *node) const;
+
+  /**
+   * @ingroup domi_omg
+   * @brief Set the attrs of a matching node on op_desc
+   */
+  Status Apply(const domi::tensorflow::NodeDef *node, const ge::OpDescPtr &op_desc) const;
+
+ private:
+  // Which field of a list AttrValue holds the values
+  enum ListKind { kListNone, kListEmpty, kListS, kListI, kListF, kListB, kListType, kListOther };
+
+  struct AttrStep {
+    std::string name;
+    domi::tensorflow::AttrValue::ValueCase value_case;
+    ListKind list_kind;
+    // VT_NONE: ignored by AutoMappingFn
+    ge::GeAttrValue::ValueType ge_type;
+  };
+
+  static ListKind GetListKind(const domi::tensorflow::AttrValue &attr_value);
+  static bool CanConvert(const AttrStep &step);
+  static bool ApplyStep(const AttrStep &step, const domi::tensorflow::AttrValue &attr_value,
+                        const ge::OpDescPtr &op_desc);
+
+  std::vector<AttrStep> steps_;
+};
+
+/**
+ * @ingroup domi_omg
+ * @brief Process wide plans keyed by tf op and IR op type, dropped when the op protos are reloaded
+ */
+class TensorFlowAutoMappingPlanCache {
+ public:
+  static TensorFlowAutoMappingPlanCache &Instance();
+
+  /**
+   * @ingroup domi_omg
+   * @brief Get the plan of key
+   * @param [out] known false if no plan was learned for key yet
+   * @return nullptr if unknown or the pair can not be planned
+   */
+  std::shared_ptr<const TensorFlowAutoMappingPlan> GetPlan(const std::string &key, bool &known);
+
+  // plan may be nullptr to record a pair that always needs AutoMappingFn
+  void SetPlan(const std::string &key, const std::shared_ptr<const TensorFlowAutoMappingPlan> &plan);
+
+ private:
+  TensorFlowAutoMappingPlanCache() = default;
+  ~TensorFlowAutoMappingPlanCache() = default;
+  void DropIfStale();
+
+  std::mutex mutex_;
+  uint64_t generation_ = 0;
+  std::unordered_map<std::string, std::shared_ptr<const TensorFlowAutoMappingPlan>> plans_;
+};
+}  // namespace ge
+
+#endif  // PARSER_TENSORFLOW_TENSORFLOW_AUTO_MAPPING_PLAN_H_
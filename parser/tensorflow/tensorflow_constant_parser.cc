@@ -27,6 +27,7 @@
 #include "graph/ge_tensor.h"
 #include "graph/utils/attr_utils.h"
 #include "parser/common/op_parser_factory.h"
+#include "parser/common/weight_precision.h"
 #include "framework/omg/parser/parser_types.h"
 #include "register/tensor_assign.h"
 
@@ -76,12 +77,38 @@ Status TensorFlowConstantParser::ParseValue(const domi::tensorflow::NodeDef *nod
   GE_CHK_STATUS_RET(domi::TensorAssign::SetGeTensorDataType(dataType, weight), "set ge tensor data type fail");
 
   GE_CHK_STATUS_RET(domi::TensorAssign::SetGeTensor(tensor, weight), "set ge tensor fail");
+  GE_CHK_STATUS_RET(ConvertWeightPrecision(opDesc, weight), "convert weight precision fail");
   GELOGI("TensorFlowConstantParser::ParseValue. TF op node name = %s", opDesc->GetName().c_str());
   GE_CHK_BOOL_RET_STATUS(ge::AttrUtils::SetTensor(opDesc, ATTR_NAME_WEIGHTS, weight), INTERNAL_ERROR,
                          "set tensor fail");
   return domi::SUCCESS;
 }
 
+Status TensorFlowConstantParser::ConvertWeightPrecision(const ge::OpDescPtr &opDesc, GeTensorPtr &weight) {
+  const ge::GeTensorDesc &weight_desc = weight->GetTensorDesc();
+  int64_t count = static_cast<int64_t>(weight->GetData().size() / sizeof(float));
+  if (!ge::parser::WeightPrecision::ShouldConvert(opDesc->GetName(), weight_desc.GetDataType(), count)) {
+    return SUCCESS;
+  }
+  // The fp32 copy only lives until the fp16 one replaces it
+  std::vector<uint16_t> half;
+  ge::parser::WeightPrecision::ToFp16(reinterpret_cast<const float *>(weight->GetData().data()), count, half);
+  ge::GeTensorDesc half_desc = weight_desc;
+  half_desc.SetDataType(ge::DT_FLOAT16);
+  ge::parser::WeightPrecision::MarkConverted(half_desc);
+  weight->SetTensorDesc(half_desc);
+  GE_CHK_BOOL_RET_STATUS(weight->SetData(reinterpret_cast<const uint8_t *>(half.data()),
+                                         half.size() * sizeof(uint16_t)) == ge::GRAPH_SUCCESS,
+                         INTERNAL_ERROR, "set fp16 data of node %s fail", opDesc->GetName().c_str());
+  ge::GeTensorDescPtr output_desc = opDesc->MutableOutputDesc(0);
+  if (output_desc != nullptr) {
+    output_desc->SetDataType(ge::DT_FLOAT16);
+    ge::parser::WeightPrecision::MarkConverted(*output_desc);
+  }
+  GELOGD("Weight of node %s is stored as fp16, %ld elements.", opDesc->GetName().c_str(), count);
+  return SUCCESS;
+}
+
 Status TensorFlowConstantParser::ParseParams(const Message *op_src, ge::OpDescPtr &op_dest) {
   GE_CHECK_NOTNULL(op_dest);
   const NodeDef *node = DOMI_DYNAMIC_CAST<const NodeDef *>(op_src);
@@ -101,5 +128,5 @@ Status TensorFlowConstantParser::ParseParams(const Message *op_src, ge::OpDescPt
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, CONSTANTOP, TensorFlowConstantParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, CONSTANTOP, TensorFlowConstantParser);
 }  // namespace ge
@@ -32,6 +32,7 @@ class TensorFlowConstantParser : public TensorFlowOpParser {
  private:
   Status ParseDType(const domi::tensorflow::NodeDef *node, ConstantOperator *op);
   Status ParseValue(const domi::tensorflow::NodeDef *node, const ge::OpDescPtr &opDesc);
+  Status ConvertWeightPrecision(const ge::OpDescPtr &opDesc, ge::GeTensorPtr &weight);
 };
 }  // namespace ge
 
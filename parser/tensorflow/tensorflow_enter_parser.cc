@@ -59,6 +59,6 @@ Status TensorFlowEnterParser::ParseParams(const Message *op_src, ge::OpDescPtr &
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, ENTER, TensorFlowEnterParser);
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, REFENTER, TensorFlowEnterParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, ENTER, TensorFlowEnterParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, REFENTER, TensorFlowEnterParser);
 }  // namespace ge
\ No newline at end of file
@@ -111,20 +111,29 @@ Status TensorFlowFusionOpParser::ParseHalfFromConst(const NodeDef *node_def, flo
   GE_CHECK_NOTNULL(node_def);
   TensorProto tensor;
   GetTensorFromNode(node_def, tensor);
+  uint16_t half_value = 0;
   if (tensor.half_val().size() > 0) {
-    auto val_vec = tensor.half_val();
+    const auto &val_vec = tensor.half_val();
     int32_t val_size = val_vec.size();
     if (index < val_size) {
-      ge::parser::fp16_t fp16_value = static_cast<parser::fp16_t>(val_vec.Get(index));
-      param = fp16_value.ToFloat();
+      half_value = static_cast<uint16_t>(val_vec.Get(index));
     } else {
       GELOGE(domi::PARAM_INVALID, "Const data size is smaller than index:%d, not supported.", index);
       return domi::PARAM_INVALID;
     }
+  } else if (tensor.has_tensor_shape() && !tensor.tensor_content().empty()) {
+    const std::string &tensor_content = tensor.tensor_content();
+    if ((index < 0) || (static_cast<uint32_t>(index) >= tensor_content.length() / sizeof(uint16_t))) {
+      GELOGE(domi::PARAM_INVALID, "Const data size is smaller than index:%d, not supported.", index);
+      return domi::PARAM_INVALID;
+    }
+    half_value = reinterpret_cast<const uint16_t *>(tensor_content.data())[index];
   } else {
     GELOGE(domi::PARAM_INVALID, "Node %s does not have half value, index:%d.", node_def->name().c_str(), index);
     return domi::PARAM_INVALID;
   }
+  ge::parser::fp16_t fp16_value(half_value);
+  param = fp16_value.ToFloat();
   return SUCCESS;
 }
 
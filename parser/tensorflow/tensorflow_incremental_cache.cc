@@ -0,0 +1,55 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parser/tensorflow/tensorflow_incremental_cache.h"
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace {
+// Graphs of one training loop are few, the bound only protects processes parsing many different models
+const size_t kMaxIncrementalGraphs = 256;
+}  // namespace
+
+TensorFlowIncrementalCache &TensorFlowIncrementalCache::Instance() {
+  static TensorFlowIncrementalCache instance;
+  return instance;
+}
+
+std::shared_ptr<const IncrementalNodeRecords> TensorFlowIncrementalCache::GetRecords(
+    const std::string &graph_key, const std::string &libraries_stamp) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = graph_records_.find(graph_key);
+  if (iter == graph_records_.end()) {
+    return nullptr;
+  }
+  if (iter->second.libraries_stamp != libraries_stamp) {
+    GELOGI("Plugins or op proto libs changed since graph %s was parsed, parse all nodes again.", graph_key.c_str());
+    graph_records_.erase(iter);
+    return nullptr;
+  }
+  return iter->second.records;
+}
+
+void TensorFlowIncrementalCache::UpdateRecords(const std::string &graph_key, const std::string &libraries_stamp,
+                                               const std::shared_ptr<const IncrementalNodeRecords> &records) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (graph_records_.size() >= kMaxIncrementalGraphs && graph_records_.count(graph_key) == 0) {
+    GELOGI("Incremental parse records exceed %zu graphs, drop all of them.", kMaxIncrementalGraphs);
+    graph_records_.clear();
+  }
+  graph_records_[graph_key] = {libraries_stamp, records};
+}
+}  // namespace ge
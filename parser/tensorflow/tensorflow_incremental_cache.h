@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_TENSORFLOW_TENSORFLOW_INCREMENTAL_CACHE_H_
+#define PARSER_TENSORFLOW_TENSORFLOW_INCREMENTAL_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "graph/op_desc.h"
+
+namespace ge {
+/**
+ * @ingroup domi_omg
+ * @brief Op parsed from one NodeDef by an earlier parse
+ */
+struct IncrementalNodeRecord {
+  // the NodeDef, its adapted op type and its input/output context, compared in full
+  std::string key;
+  // private copy of the parsed op, never added to a graph. Only nodes found unchanged by a parse get one, so a
+  // graph parsed once keeps no copies.
+  ge::OpDescPtr op_desc;
+};
+
+using IncrementalNodeRecords = std::unordered_map<std::string, IncrementalNodeRecord>;
+
+/**
+ * @ingroup domi_omg
+ * @brief Process wide record of the ops built by the last parse of every graph, so that a repeated
+ *        ParseProtoWithSubgraph only runs the op parsers of nodes whose NodeDef or neighbourhood changed.
+ *        The first parse only records node keys, ops of unchanged nodes are copied by the second and reused from
+ *        the third parse on.
+ *        Graphs are keyed by the root graph and graph name, records of other libraries stamps are dropped.
+ */
+class TensorFlowIncrementalCache {
+ public:
+  static TensorFlowIncrementalCache &Instance();
+
+  /**
+   * @ingroup domi_omg
+   * @brief Get the records of the last successful parse of graph_key
+   * @param [in] libraries_stamp stamp of the plugins and op proto libs of this parse
+   * @return nullptr if the graph was never parsed, or parsed with other libraries
+   */
+  std::shared_ptr<const IncrementalNodeRecords> GetRecords(const std::string &graph_key,
+                                                           const std::string &libraries_stamp);
+
+  /**
+   * @ingroup domi_omg
+   * @brief Replace the records of graph_key by the records of the parse that just succeeded
+   */
+  void UpdateRecords(const std::string &graph_key, const std::string &libraries_stamp,
+                     const std::shared_ptr<const IncrementalNodeRecords> &records);
+
+ private:
+  TensorFlowIncrementalCache() = default;
+  ~TensorFlowIncrementalCache() = default;
+
+  std::mutex mutex_;
+  struct GraphRecords {
+    std::string libraries_stamp;
+    std::shared_ptr<const IncrementalNodeRecords> records;
+  };
+  std::unordered_map<std::string, GraphRecords> graph_records_;
+};
+}  // namespace ge
+
+#endif  // PARSER_TENSORFLOW_TENSORFLOW_INCREMENTAL_CACHE_H_
@@ -48,5 +48,5 @@ Status TensorFlowMergeParser::ParseParams(const Message *op_src, ge::OpDescPtr &
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, MERGE, TensorFlowMergeParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, MERGE, TensorFlowMergeParser);
 }
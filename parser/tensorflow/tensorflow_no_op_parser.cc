@@ -35,5 +35,5 @@ Status TensorFlowNoOpParser::ParseParams(const Message *op_src, ge::OpDescPtr &o
   return ConvertToOpDesc(op, op_dest);
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, NOOP, TensorFlowNoOpParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, NOOP, TensorFlowNoOpParser);
 }  // namespace ge
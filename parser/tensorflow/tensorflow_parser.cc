@@ -17,6 +17,7 @@
 #include "parser/tensorflow/tensorflow_parser.h"
 #include <algorithm>
 #include <iostream>
+#include <unordered_set>
 #include "parser/common/convert/pb2json.h"
 #include "common/debug/log.h"
 #include "parser/common/acl_graph_parser_util.h"
@@ -27,7 +28,10 @@
 #include "framework/common/debug/ge_log.h"
 #include "framework/omg/parser/parser_api.h"
 #include "framework/omg/parser/parser_inner_ctx.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "graph/debug/ge_attr_define.h"
+#include "graph/ge_local_context.h"
 #include "graph/optimize/common/params.h"
 #include "graph/passes/variable_format_pass.h"
 #include "graph/utils/graph_utils.h"
@@ -41,16 +45,23 @@
 #include "parser/common/model_saver.h"
 #include "parser/common/op_map.h"
 #include "parser/common/op_parser_factory.h"
+#include "parser/common/op_types_without_ir.h"
+#include "parser/common/parse_cache.h"
+#include "parser/common/parse_options.h"
 #include "parser/common/parser_fp16_t.h"
 #include "parser/common/pass_manager.h"
 #include "parser/common/pre_checker.h"
+#include "parser/common/tbe_plugin_loader.h"
 #include "parser/common/thread_pool.h"
+#include "parser/common/weight_precision.h"
 #include "parser/common/parser_utils.h"
 #include "parser/tensorflow/tensorflow_custom_parser_adapter.h"
 #include "parser/tensorflow/tensorflow_fusion_custom_parser_adapter.h"
 #include "parser/tensorflow/tensorflow_fusion_op_parser.h"
 #include "parser/tensorflow/tensorflow_fusionop_util.h"
+#include "parser/tensorflow/tensorflow_incremental_cache.h"
 #include "parser/tensorflow/tensorflow_op_parser.h"
+#include "parser/tensorflow/tensorflow_shape_folding.h"
 #include "parser/tensorflow/tensorflow_util.h"
 #include "register/op_registry.h"
 #include "register/scope/scope_graph_impl.h"
@@ -126,6 +137,8 @@ graphStatus aclgrphParseTensorFlow(const char *model_file, ge::Graph &graph) {
 graphStatus aclgrphParseTensorFlow(const char *model_file, const std::map<AscendString, AscendString> &parser_params,
                                    ge::Graph &graph) {
   GE_CHECK_NOTNULL(model_file);
+  ge::parser::ParserProfileSession profile_session(parser_params);
+  PARSER_PROFILE_SCOPE("aclgrphParseTensorFlow");
   GetParserContext().type = domi::TENSORFLOW;
   std::map<string, string> options;
   options.insert(std::pair<string, string>(string(ge::FRAMEWORK_TYPE), to_string(ge::TENSORFLOW)));
@@ -139,25 +152,43 @@ graphStatus aclgrphParseTensorFlow(const char *model_file, const std::map<Ascend
     GELOGE(ge::FAILED, "Parser params before graph failed.");
     return ge::FAILED;
   }
+  ge::parser::ParseOptionsScope parse_options_scope(acl_graph_parse_util.GetParseOptions());
   // Create an empty computegraph
   string graph_name = output_name.empty() ? "tmpGraph" : output_name;
   ge::ComputeGraphPtr compute_graph = ge::parser::MakeShared<ge::ComputeGraph>(graph_name);
   GE_CHECK_NOTNULL(compute_graph);
 
   graph = ge::GraphUtils::CreateGraphFromComputeGraph(compute_graph);
-  auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::TENSORFLOW);
-  GE_CHECK_NOTNULL(model_parser);
 
-  // parse tensorflow model_file to GE graph
-  ge::graphStatus ret = model_parser->Parse(model_file, graph);
-  if (ret != ge::SUCCESS) {
-    GELOGE(ret, "Parser graph %s failed.", graph.GetName().c_str());
+  ge::parser::ParseCache parse_cache;
+  // Models with function operators also read the function library next to the model file
+  if (parse_cache.Init({model_file}, parser_params,
+                       {TensorFlowModelParser::GetFunctionLibraryPath(model_file)}) != ge::SUCCESS) {
+    GELOGE(ge::FAILED, "Init parse cache of %s failed.", model_file);
     return ge::FAILED;
   }
+  if (!parse_cache.Load(graph)) {
+    auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::TENSORFLOW);
+    GE_CHECK_NOTNULL(model_parser);
 
-  if (acl_graph_parse_util.ParseParamsAfterGraph(graph, parser_params) != ge::SUCCESS) {
-    GELOGE(ge::FAILED, "Parser params after graph failed.");
-    return ge::FAILED;
+    // parse tensorflow model_file to GE graph
+    ge::graphStatus ret = model_parser->Parse(model_file, graph);
+    if (ret != ge::SUCCESS) {
+      GELOGE(ret, "Parser graph %s failed.", graph.GetName().c_str());
+      return ge::FAILED;
+    }
+
+    PARSER_TIMESTAMP_START(ParseParamsAfterGraph);
+    if (acl_graph_parse_util.ParseParamsAfterGraph(graph, parser_params) != ge::SUCCESS) {
+      GELOGE(ge::FAILED, "Parser params after graph failed.");
+      return ge::FAILED;
+    }
+    PARSER_TIMESTAMP_END(ParseParamsAfterGraph, "AclGrphParseUtil::ParseParamsAfterGraph");
+    if (ge::parser::WeightPrecision::InsertCasts(ge::GraphUtils::GetComputeGraph(graph)) != ge::SUCCESS) {
+      GELOGE(ge::FAILED, "Insert casts behind fp16 weights of graph %s failed.", graph.GetName().c_str());
+      return ge::FAILED;
+    }
+    parse_cache.Save(graph);
   }
 
   if (acl_graph_parse_util.SetOutputNodeInfo(graph, parser_params) != ge::SUCCESS) {
@@ -173,18 +204,37 @@ namespace ge {
 namespace {
 const int kTransposeInputIdx = 0;
 const uint32_t kThreadNum = 16;
-const size_t kInputNumUint = 2;
+const size_t kMinOpNodesPerEdgeTask = 1024;
 const int kInputNumInt = 2;
 const int32_t kControlSlot = -1;
 const size_t kSoftmaxMultiple = 2;
 const set<string> kTfBlackFields = {"tensor_content"};
 const std::vector<std::string> kSkipCheckoutInputSizeNodes = {ge::parser::DATA, ge::parser::VARIABLE,
                                                               ge::parser::FRAMEWORKOP, ge::parser::LAYERNORM};
-const std::vector<std::string> kMakeOperatorNotByIr = {ge::parser::ARG, ge::parser::VARIABLE, ge::parser::VARHANDLEOP,
-                                                       ge::parser::FRAMEWORKOP, ge::parser::DATA};
+const std::unordered_set<std::string> kMakeOperatorNotByIr = {ge::parser::ARG, ge::parser::VARIABLE,
+                                                              ge::parser::VARHANDLEOP, ge::parser::FRAMEWORKOP,
+                                                              ge::parser::DATA};
 const char *const kDpop = "DPOP";
 const char *const kFuncDefLibraryFilePath = "graph_def_library.pbtxt";
 const char *const kAttrNameIsScopeInnerNode = "_is_scope_inner_node";
+// Op parsers of these types write the parser context, so their nodes are always parsed again
+const std::set<std::string> kIncrementalParseSkipTypes = {ge::parser::DATA, ge::parser::ARG, ge::parser::CONSTANT};
+const char *const kRetvalOpType = "_Retval";
+// Ops known to compute their outputs from their inputs only, dead node removal may drop them. Any other op may
+// have side effects, such as writing a variable, a queue or a stack, or printing, and is kept without consumers.
+const std::set<std::string> kPureOpTypes = {
+    "Const", "Identity", "IdentityN", "Snapshot", "StopGradient", "PreventGradient", "NoOp",
+    "Shape", "ShapeN", "Size", "Rank", "Reshape", "Squeeze", "ExpandDims", "Transpose", "ConcatV2", "Concat",
+    "Pack", "Unpack", "Split", "SplitV", "Slice", "StridedSlice", "Gather", "GatherV2", "GatherNd", "Tile",
+    "Pad", "PadV2", "Fill", "ZerosLike", "OnesLike", "Range", "Cast", "Select", "SelectV2",
+    "Add", "AddV2", "AddN", "Sub", "Mul", "Div", "RealDiv", "FloorDiv", "FloorMod", "Maximum", "Minimum",
+    "Pow", "SquaredDifference", "Neg", "Abs", "Sign", "Square", "Sqrt", "Rsqrt", "Reciprocal", "Exp", "Log",
+    "Floor", "Ceil", "Round", "Equal", "NotEqual", "Less", "LessEqual", "Greater", "GreaterEqual",
+    "LogicalAnd", "LogicalOr", "LogicalNot", "Sum", "Mean", "Max", "Min", "Prod", "All", "Any", "ArgMax",
+    "ArgMin", "MatMul", "BatchMatMul", "BatchMatMulV2", "BiasAdd", "Conv2D", "DepthwiseConv2dNative",
+    "MaxPool", "AvgPool", "FusedBatchNorm", "FusedBatchNormV3", "Relu", "Relu6", "Elu", "Selu", "Softplus",
+    "Sigmoid", "Tanh", "Softmax", "LogSoftmax"};
+
 struct ParseArg {
   const google::protobuf::Message *proto;
   std::string function_name;
@@ -229,6 +279,54 @@ Status GenSubgraphParseTasks(const ge::ComputeGraphPtr &parent_graph, std::deque
   return SUCCESS;
 }
 
+// A function body parsed once in a model, later call sites get a copy of its graph
+struct ParsedFunction {
+  ge::ComputeGraphPtr graph;
+  domiTensorFormat_t format;
+};
+using ParsedFunctions = std::map<std::string, ParsedFunction>;
+
+// Keep an untouched copy of a parsed function, the graph of the call site is post-processed and changed later
+Status RecordParsedFunction(const ParseArg &arg, ParsedFunctions &parsed_functions) {
+  if (arg.parent_node == nullptr) {
+    return SUCCESS;
+  }
+  auto graph = ge::parser::MakeShared<ge::ComputeGraph>(arg.function_name);
+  if (graph == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to alloc graph for function %s", arg.function_name.c_str());
+    return OUT_OF_MEMORY;
+  }
+  GE_CHK_STATUS_RET(ParserUtils::CopyComputeGraph(arg.graph, graph), "Failed to copy graph of function %s",
+                    arg.function_name.c_str());
+  parsed_functions[arg.function_name] = {graph, ge::GetParserContext().format};
+  return SUCCESS;
+}
+
+Status CopyParsedFunction(const ParsedFunctions &parsed_functions, const ParseArg &arg, bool &copied) {
+  copied = false;
+  if (arg.parent_node == nullptr) {
+    return SUCCESS;
+  }
+  auto iter = parsed_functions.find(arg.function_name);
+  if (iter == parsed_functions.end()) {
+    return SUCCESS;
+  }
+  GE_CHK_STATUS_RET(ParserUtils::CopyComputeGraph(iter->second.graph, arg.graph),
+                    "Failed to copy parsed function %s to graph %s", arg.function_name.c_str(),
+                    arg.graph->GetName().c_str());
+  std::vector<std::string> user_inputs_order;
+  for (auto &input : ge::GetParserContext().user_input_dims) {
+    user_inputs_order.push_back(input.first);
+  }
+  arg.graph->SetInputsOrder(user_inputs_order);
+  // Parsing the function sets the input format in the parser context, copying it has to do the same
+  ge::GetParserContext().format = iter->second.format;
+  GELOGI("Function %s is parsed already, copy it to graph %s", arg.function_name.c_str(),
+         arg.graph->GetName().c_str());
+  copied = true;
+  return SUCCESS;
+}
+
 Status PostOpProcessForSubgraph(const ParseArg &arg) {
   if (arg.parent_node == nullptr) {
     return SUCCESS;
@@ -326,9 +424,9 @@ Status TensorFlowModelParser::TransNodeToOpDesc(const domi::tensorflow::NodeDef
                                                 const string &op_type) {
   GE_CHECK_NOTNULL(node_def);
   string node_name = node_def->name();
-  ge::Operator op_factory = ge::OperatorFactory::CreateOperator(node_name, op_type);
-  if (op_factory.GetName() != node_name || op_type == ge::parser::DATA) {
-    if (std::find(kMakeOperatorNotByIr.begin(), kMakeOperatorNotByIr.end(), op_type) != kMakeOperatorNotByIr.end()) {
+  op = (op_type == ge::parser::DATA) ? nullptr : ge::OpTypesWithoutIr::Instance().CreateOpDesc(node_name, op_type);
+  if (op == nullptr) {
+    if (kMakeOperatorNotByIr.count(op_type) > 0) {
       op = ge::parser::MakeShared<ge::OpDesc>(node_name, op_type);
       GE_CHECK_NOTNULL(op);
     } else if (node_name == op_type) {
@@ -341,8 +439,6 @@ Status TensorFlowModelParser::TransNodeToOpDesc(const domi::tensorflow::NodeDef
       return FAILED;
     }
   } else {
-    op = ge::OpDescUtils::GetOpDescFromOperator(op_factory);
-    GE_CHECK_NOTNULL(op);
     GELOGI("After GetOpDescFromOperator op[%s]: type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
            op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
 
@@ -350,7 +446,6 @@ Status TensorFlowModelParser::TransNodeToOpDesc(const domi::tensorflow::NodeDef
     GELOGI("After AddTensorDescToOpDesc op[%s]: type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
            op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
   }
-  op_factory.BreakConnect();
   return SUCCESS;
 }
 
@@ -403,8 +498,10 @@ Status TensorFlowModelParser::AddNode(const domi::tensorflow::NodeDef *node_def,
     return AddScopeInnerNode(this, graph, &graph_mutex, node_def);
   }
   // node is released in destructor
+  ge::parser::ParserProfileScope profile_scope("AddNode");
   string node_name = node_def->name();
   string node_op = node_def->op();
+  profile_scope.SetOpType(node_op);
   auto type_it = tensorflow_op_map.find(node_op);
   if (type_it == tensorflow_op_map.end()) {
     GELOGI("Can not find,maybe this node has no plugin node_name is %s, node_op is %s ", node_name.c_str(),
@@ -652,90 +749,157 @@ Status TensorFlowModelParser::AddTensorDescToOpDesc(ge::OpDescPtr &op_desc, cons
   return SUCCESS;
 }
 
+Status TensorFlowModelParser::ResolveOpNodeEdges(const string &src_op_name, const OpNodeContext &src_context,
+                                                 OpNodeEdges &edges) {
+  auto src_iter = node_map_.find(src_op_name);
+  if (src_iter == node_map_.end()) {
+    return SUCCESS;
+  }
+  edges.src = src_iter->second;
+  // Traverse all output of the op_node
+  for (const auto &src_output_iter : src_context.output_map) {
+    const string &dest_op_name = src_output_iter.first;
+    auto dest_iter = op_node_context_map_.find(dest_op_name);
+    if (dest_iter == op_node_context_map_.end()) {
+      continue;
+    }
+    // Find that the output of the source node is equal to the destination node
+    std::map<std::string, std::vector<std::pair<int32_t, int32_t>>> &dest_input_map = dest_iter->second.input_map;
+    auto input_iter = dest_input_map.find(src_op_name);
+    // Find output and input
+    if (input_iter == dest_input_map.end()) {
+      continue;
+    }
+    auto dest_node_iter = node_map_.find(dest_op_name);
+    if (dest_node_iter == node_map_.end()) {
+      continue;
+    }
+    GE_CHECK_NOTNULL(edges.src);
+    // Each pair builds an edge
+    ge::NodePtr dest = dest_node_iter->second;
+    GE_CHECK_NOTNULL(dest);
+    if (src_output_iter.second.size() != input_iter->second.size()) {
+      ErrorManager::GetInstance().ATCReportErrMessage("E12021", {"opname1", "index1", "opname2", "index2"},
+                                                      {src_op_name, std::to_string(input_iter->second.size()),
+                                                       dest_op_name, std::to_string(src_output_iter.second.size())});
+      GELOGE(INTERNAL_ERROR, "Input size of op[%s]:%d is not equal to Output size of op[%s]:%d.", src_op_name.c_str(),
+             input_iter->second.size(), dest_op_name.c_str(), src_output_iter.second.size());
+      return INTERNAL_ERROR;
+    }
+    for (const auto &outputpair : src_output_iter.second) {
+      // Get control edge properties
+      bool control = GetEdgesControlInfo(dest_op_name, outputpair.second);
+      edges.links.push_back({dest, outputpair.first, outputpair.second, control});
+    }
+    edges.consumed_inputs.emplace_back(&dest_iter->second, input_iter);
+  }
+
+  // Only control edges depend on whether the source is a Switch, data only sources need no nodedef
+  bool has_control = std::any_of(edges.links.begin(), edges.links.end(),
+                                 [](const OpNodeEdgeLink &link) { return link.control; });
+  if (has_control) {
+    auto node_def_iter = nodedef_map_.find(src_op_name);
+    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG((node_def_iter == nodedef_map_.end()) || (node_def_iter->second == nullptr),
+                                   return INTERNAL_ERROR, "Can't find nodedef of op[%s].", src_op_name.c_str());
+    edges.is_switch = (node_def_iter->second->op() == TENSORFLOWF_NODE_OP_SWITCH);
+  }
+  return SUCCESS;
+}
+
+Status TensorFlowModelParser::LinkOpNodeEdges(const OpNodeEdges &edges) {
+  const ge::NodePtr &src = edges.src;
+  for (const auto &link : edges.links) {
+    const ge::NodePtr &dest = link.dest;
+    PARSER_TRACE(link.control ? "AddControlEdge" : "AddEdge", dest->GetName(), link.src_index, link.dest_index);
+    // Graph create new edge
+    if (!link.control) {
+      PARSER_LOGD("Start add edge: from %s:%d to %s:%d.", src->GetName().c_str(), link.src_index,
+                  dest->GetName().c_str(), link.dest_index);
+      ge::OutDataAnchorPtr out_archor_ptr = src->GetOutDataAnchor(link.src_index);
+      GE_CHECK_NOTNULL(out_archor_ptr);
+      ge::InDataAnchorPtr in_archor_ptr = dest->GetInDataAnchor(link.dest_index);
+      GE_CHECK_NOTNULL(in_archor_ptr);
+      GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ge::GraphUtils::AddEdge(out_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
+                                     ErrorManager::GetInstance().ATCReportErrMessage(
+                                         "E12014", {"opname1", "opname2"}, {src->GetName(), dest->GetName()});
+                                     return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].",
+                                            src->GetName().c_str(), dest->GetName().c_str());
+    } else {
+      PARSER_LOGD("Start add contorl edge: from %s to %s.", src->GetName().c_str(), dest->GetName().c_str());
+      ge::InControlAnchorPtr in_archor_ptr = dest->GetInControlAnchor();
+      GE_CHECK_NOTNULL(in_archor_ptr);
+      GE_IF_BOOL_EXEC(!edges.is_switch,
+                      ge::OutControlAnchorPtr out_archor_ptr = src->GetOutControlAnchor();
+                      GE_CHECK_NOTNULL(out_archor_ptr); GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
+                          ge::GraphUtils::AddEdge(out_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
+                          ErrorManager::GetInstance().ATCReportErrMessage("E12014", {"opname1", "opname2"},
+                                                                          {src->GetName(), dest->GetName()});
+                          return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].", src->GetName().c_str(),
+                                 dest->GetName().c_str()););
+
+      GE_IF_BOOL_EXEC(edges.is_switch,
+                      ge::OutDataAnchorPtr out_data_archor_ptr = src->GetOutDataAnchor(link.src_index);
+                      GE_CHECK_NOTNULL(out_data_archor_ptr); GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
+                          ge::GraphUtils::AddEdge(out_data_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
+                          ErrorManager::GetInstance().ATCReportErrMessage("E12014", {"opname1", "opname2"},
+                                                                          {src->GetName(), dest->GetName()});
+                          return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].", src->GetName().c_str(),
+                                 dest->GetName().c_str()););
+    }
+  }
+  for (const auto &consumed_input : edges.consumed_inputs) {
+    consumed_input.first->input_map.erase(consumed_input.second);
+  }
+  return SUCCESS;
+}
+
 Status TensorFlowModelParser::AddEdges(ge::ComputeGraphPtr &graph) {
   GE_CHECK_NOTNULL(graph);
-  for (auto &src_iter : op_node_context_map_) {
-    string src_op_name = src_iter.first;
-    OpNodeContext src_op_node_context = src_iter.second;
-    std::map<std::string, std::vector<std::pair<int32_t, int32_t>>> &src_output_map = src_op_node_context.output_map;
-    // Traverse all output of the op_node
-    for (auto &src_output_iter : src_output_map) {
-      string dest_op_name = src_output_iter.first;
-      auto dest_iter = op_node_context_map_.find(dest_op_name);
-      if (dest_iter == op_node_context_map_.end()) {
-        continue;
-      }
-      // Find that the output of the source node is equal to the destination node
-      std::map<std::string, std::vector<std::pair<int32_t, int32_t>>> &dest_input_map = dest_iter->second.input_map;
-      auto input_iter = dest_input_map.find(src_op_name);
-      // Find output and input
-      if (input_iter == dest_input_map.end()) {
-        continue;
-      }
-      auto iter = node_map_.find(src_op_name);
-      if (iter == node_map_.end()) {
-        continue;
-      }
-      ge::NodePtr src = iter->second;
-      GE_CHECK_NOTNULL(src);
-      auto iter1 = node_map_.find(dest_op_name);
-      if (iter1 == node_map_.end()) {
-        continue;
-      }
-      // Each pair builds an edge
-      ge::NodePtr dest = iter1->second;
-      GE_CHECK_NOTNULL(dest);
-      if (src_output_iter.second.size() != input_iter->second.size()) {
-        ErrorManager::GetInstance().ATCReportErrMessage("E12021", {"opname1", "index1", "opname2", "index2"},
-                                                        {src_op_name, std::to_string(input_iter->second.size()),
-                                                         dest_op_name, std::to_string(src_output_iter.second.size())});
-        GELOGE(INTERNAL_ERROR, "Input size of op[%s]:%d is not equal to Output size of op[%s]:%d.", src_op_name.c_str(),
-               input_iter->second.size(), dest_op_name.c_str(), src_output_iter.second.size());
-        return INTERNAL_ERROR;
-      }
-      for (auto &outputpair : src_output_iter.second) {
-        // Get control edge properties
-        bool control = GetEdgesControlInfo(dest_op_name, outputpair.second);
-        // Graph create new edge
-        if (!control) {
-          GELOGD("Start add edge: from %s:%d to %s:%d.", src->GetName().c_str(), outputpair.first,
-                 dest->GetName().c_str(), outputpair.second);
-          ge::OutDataAnchorPtr out_archor_ptr = src->GetOutDataAnchor(outputpair.first);
-          GE_CHECK_NOTNULL(out_archor_ptr);
-          ge::InDataAnchorPtr in_archor_ptr = dest->GetInDataAnchor(outputpair.second);
-          GE_CHECK_NOTNULL(in_archor_ptr);
-          GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ge::GraphUtils::AddEdge(out_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
-                                         ErrorManager::GetInstance().ATCReportErrMessage(
-                                             "E12014", {"opname1", "opname2"}, {src->GetName(), dest->GetName()});
-                                         return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].",
-                                                src->GetName().c_str(), dest->GetName().c_str());
-        } else {
-          GELOGD("Start add contorl edge: from %s to %s.", src->GetName().c_str(), dest->GetName().c_str());
-          ge::InControlAnchorPtr in_archor_ptr = dest->GetInControlAnchor();
-          GE_CHECK_NOTNULL(in_archor_ptr);
-          GE_IF_BOOL_EXEC(nodedef_map_[src_op_name]->op() != TENSORFLOWF_NODE_OP_SWITCH,
-                          ge::OutControlAnchorPtr out_archor_ptr = src->GetOutControlAnchor();
-                          GE_CHECK_NOTNULL(out_archor_ptr); GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-                              ge::GraphUtils::AddEdge(out_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
-                              ErrorManager::GetInstance().ATCReportErrMessage("E12014", {"opname1", "opname2"},
-                                                                              {src->GetName(), dest->GetName()});
-                              return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].", src->GetName().c_str(),
-                                     dest->GetName().c_str()););
-
-          GE_IF_BOOL_EXEC(nodedef_map_[src_op_name]->op() == TENSORFLOWF_NODE_OP_SWITCH,
-                          ge::OutDataAnchorPtr out_data_archor_ptr = src->GetOutDataAnchor(outputpair.first);
-                          GE_CHECK_NOTNULL(out_data_archor_ptr); GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-                              ge::GraphUtils::AddEdge(out_data_archor_ptr, in_archor_ptr) != ge::GRAPH_SUCCESS,
-                              ErrorManager::GetInstance().ATCReportErrMessage("E12014", {"opname1", "opname2"},
-                                                                              {src->GetName(), dest->GetName()});
-                              return INTERNAL_ERROR, "Add link failed from op[%s] to op[%s].", src->GetName().c_str(),
-                                     dest->GetName().c_str()););
-        }
+  std::vector<const std::pair<const string, OpNodeContext> *> src_contexts;
+  src_contexts.reserve(op_node_context_map_.size());
+  for (const auto &src_iter : op_node_context_map_) {
+    src_contexts.push_back(&src_iter);
+  }
+
+  // Resolving the edges only reads the parser maps, so it runs in parallel over ranges of source nodes.
+  // Linking stays serial: an out anchor is shared by all its destinations, so no partition of the
+  // edges keeps concurrent AddEdge calls off the same anchor.
+  std::vector<OpNodeEdges> all_edges(src_contexts.size());
+  auto resolve_range = [this, &src_contexts, &all_edges](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      GE_RETURN_IF_ERROR(ResolveOpNodeEdges(src_contexts[i]->first, src_contexts[i]->second, all_edges[i]));
+    }
+    return SUCCESS;
+  };
+  size_t task_num = std::min(static_cast<size_t>(kThreadNum),
+                             (src_contexts.size() + kMinOpNodesPerEdgeTask - 1) / kMinOpNodesPerEdgeTask);
+  if (task_num <= 1) {
+    GE_RETURN_IF_ERROR(resolve_range(0, src_contexts.size()));
+  } else {
+    ThreadPool executor(static_cast<uint32_t>(task_num));
+    std::vector<std::future<Status>> futures;
+    size_t range_size = (src_contexts.size() + task_num - 1) / task_num;
+    for (size_t begin = 0; begin < src_contexts.size(); begin += range_size) {
+      std::future<Status> f = executor.commit(resolve_range, begin, std::min(begin + range_size, src_contexts.size()));
+      if (!f.valid()) {
+        GELOGE(FAILED, "Future is invalid");
+        return FAILED;
       }
-      dest_input_map.erase(input_iter);
+      futures.push_back(std::move(f));
+    }
+    Status ret = SUCCESS;
+    for (auto &f : futures) {
+      Status range_ret = f.get();
+      ret = (ret == SUCCESS) ? range_ret : ret;
+    }
+    if (ret != SUCCESS) {
+      return ret;
     }
   }
 
+  for (const auto &edges : all_edges) {
+    GE_RETURN_IF_ERROR(LinkOpNodeEdges(edges));
+  }
   return SUCCESS;
 }
 
@@ -797,10 +961,12 @@ Status TensorFlowModelParser::CheckOpType(const domi::tensorflow::NodeDef *node_
 
   GE_IF_BOOL_EXEC(
       op_type == ge::parser::ADD || op_type == ge::parser::MULTIPLY || op_type == ge::parser::MEAN,
+      string tmp_input_name;
       for (const string &input_name
            : node_def->input()) {
-        string tmp_input_name;
-        GE_RETURN_IF_ERROR(CheckInputNodeName(input_name, &tmp_input_name, nullptr, nullptr));
+        TfInputName input;
+        (void)TensorFlowUtil::ParseInputName(input_name, input);
+        input.AssignName(tmp_input_name);
         GELOGD("Add or Mul op %s input name is %s", node_name.c_str(), input_name.c_str());
         GE_IF_BOOL_EXEC(framework_ops_.find(tmp_input_name) != framework_ops_.end(),
                         GELOGI("Set op %s to frameworkop", node_name.c_str());
@@ -825,9 +991,11 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
                                            std::mutex *graphMutex, shared_ptr<ge::ScopeGraph> &scope_graph,
                                            const domi::tensorflow::NodeDef *node_def) {
   // The caller guarantees that the pointer is not null
+  ge::parser::ParserProfileScope profile_scope("ParseNodeDef");
   string node_name = node_def->name();
   string node_op = node_def->op();
-  GELOGD("TF op node name = %s, op type= %s", node_name.c_str(), node_op.c_str());
+  profile_scope.SetOpType(node_op);
+  PARSER_LOGD("TF op node name = %s, op type= %s", node_name.c_str(), node_op.c_str());
   domi::tensorflow::AttrValue attr_value;
   if (ge::TensorFlowUtil::FindAttrValue(node_def, kAttrNameIsScopeInnerNode, attr_value) && attr_value.b()) {
     return AddScopeInnerNode(parser, graph, graphMutex, node_def);
@@ -838,22 +1006,49 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
                                  "get adapted op type failed, node name = %s", node_name.c_str());
 
   string op_type = iterator->second;
-  // Log printing for determining operator type
-  domi::ImplyType implyType = domi::OpRegistry::Instance()->GetImplyType(op_type);
-  GE_IF_BOOL_EXEC((implyType == domi::ImplyType::TVM) && (op_type != ge::parser::FRAMEWORKOP),
-                  GELOGD("TBE %s parsering", node_op.c_str()););
-  GE_IF_BOOL_EXEC((implyType == domi::ImplyType::CCE) && (op_type != ge::parser::FRAMEWORKOP),
-                  GELOGD("CCE %s parsering", node_op.c_str()););
-  GE_IF_BOOL_EXEC((implyType == domi::ImplyType::HCCL) && (op_type != ge::parser::FRAMEWORKOP),
-                  GELOGD("HCCL %s parsering", node_op.c_str()););
-  GE_IF_BOOL_EXEC(op_type == ge::parser::FRAMEWORKOP, GELOGD("FRAMEWORKOP %s parsering", node_op.c_str()););
-  GELOGD("TF op node name = %s, op type= %s, trans to op type %s", node_name.c_str(), node_op.c_str(), op_type.c_str());
+  // Log printing for determining operator type, the imply type is only looked up for it
+  if (PARSER_LOG_ENABLED(DLOG_DEBUG)) {
+    domi::ImplyType implyType = domi::OpRegistry::Instance()->GetImplyType(op_type);
+    GE_IF_BOOL_EXEC((implyType == domi::ImplyType::TVM) && (op_type != ge::parser::FRAMEWORKOP),
+                    GELOGD("TBE %s parsering", node_op.c_str()););
+    GE_IF_BOOL_EXEC((implyType == domi::ImplyType::CCE) && (op_type != ge::parser::FRAMEWORKOP),
+                    GELOGD("CCE %s parsering", node_op.c_str()););
+    GE_IF_BOOL_EXEC((implyType == domi::ImplyType::HCCL) && (op_type != ge::parser::FRAMEWORKOP),
+                    GELOGD("HCCL %s parsering", node_op.c_str()););
+    GE_IF_BOOL_EXEC(op_type == ge::parser::FRAMEWORKOP, GELOGD("FRAMEWORKOP %s parsering", node_op.c_str()););
+  }
+  PARSER_LOGD("TF op node name = %s, op type= %s, trans to op type %s", node_name.c_str(), node_op.c_str(),
+              op_type.c_str());
+
+  // Nodes unchanged since the last parse of this graph reuse the op built then
+  bool record_node = parser->incremental_parse_ && (kIncrementalParseSkipTypes.count(op_type) == 0) &&
+                     !parser->IsFusionOp(scope_graph, node_def);
+  string node_key;
+  const IncrementalNodeRecord *prev_record = nullptr;
+  if (record_node) {
+    node_key = parser->GetNodeKey(node_def, op_type);
+    prev_record = parser->FindUnchangedNode(node_name, node_key);
+    ge::OpDescPtr reused_op = (prev_record != nullptr) ? parser->ReuseRecordedOp(node_name, *prev_record) : nullptr;
+    if (reused_op != nullptr) {
+      PARSER_LOGD("TF op node name = %s is unchanged since last parse, reuse its op", node_name.c_str());
+      ge::NodePtr node;
+      {
+        std::lock_guard<std::mutex> lock(*graphMutex);
+        node = graph->AddNode(reused_op);
+      }
+      GE_CHK_BOOL_TRUE_EXEC_WITH_LOG((node == nullptr), return INTERNAL_ERROR, "add node failed.");
+      {
+        std::lock_guard<std::mutex> lock(parser->nodeMapMutex_);
+        parser->node_map_[node_name] = node;
+      }
+      return SUCCESS;
+    }
+  }
 
   // Construct operator by IR
-  ge::OpDescPtr op;
-  ge::Operator op_factory = ge::OperatorFactory::CreateOperator(node_name, op_type);
-  if (op_factory.GetName() != node_name) {
-    if (std::find(kMakeOperatorNotByIr.begin(), kMakeOperatorNotByIr.end(), op_type) != kMakeOperatorNotByIr.end()) {
+  ge::OpDescPtr op = ge::OpTypesWithoutIr::Instance().CreateOpDesc(node_name, op_type);
+  if (op == nullptr) {
+    if (kMakeOperatorNotByIr.count(op_type) > 0) {
       op = ge::parser::MakeShared<ge::OpDesc>(node_name, op_type);
       GE_CHECK_NOTNULL(op);
     } else if (node_name == op_type) {
@@ -878,24 +1073,21 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
       return FAILED;
     }
   } else {
-    op = ge::OpDescUtils::GetOpDescFromOperator(op_factory);
-    GE_CHECK_NOTNULL(op);
-    GELOGD("After GetOpDescFromOperator op[%s] type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
-           op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
+    PARSER_LOGD("After GetOpDescFromOperator op[%s] type[%s] have input size: %zu, output size: %zu",
+                op->GetName().c_str(), op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
 
     GE_RETURN_IF_ERROR(parser->AddTensorDescToOpDesc(op, node_def));
-    GELOGD("After AddTensorDescToOpDesc op[%s] type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
-           op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
+    PARSER_LOGD("After AddTensorDescToOpDesc op[%s] type[%s] have input size: %zu, output size: %zu",
+                op->GetName().c_str(), op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
   }
-  GELOGD("TF op node name = %s, outpusize= %zu", node_name.c_str(), op->GetAllOutputsDesc().size());
-  op_factory.BreakConnect();
+  PARSER_LOGD("TF op node name = %s, outpusize= %zu", node_name.c_str(), op->GetAllOutputsDesc().size());
 
   // create OpParser
   shared_ptr<OpParserFactory> factory = OpParserFactory::Instance(domi::TENSORFLOW);
   GE_CHECK_NOTNULL(factory);
   bool needFusion = parser->IsFusionOp(scope_graph, node_def);
-  GELOGD("TF op node name = %s, op type= %s is fusion op(NO: 0; YES: 1)= %d", node_name.c_str(), node_op.c_str(),
-         needFusion);
+  PARSER_LOGD("TF op node name = %s, op type= %s is fusion op(NO: 0; YES: 1)= %d", node_name.c_str(),
+              node_op.c_str(), needFusion);
 
   Status status = FAILED;
   if (!needFusion) {
@@ -906,11 +1098,16 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
       return status;
     }
   }
-  GELOGD("After op parser op[%s] type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
-         op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
+  PARSER_LOGD("After op parser op[%s] type[%s] have input size: %zu, output size: %zu", op->GetName().c_str(),
+              op->GetType().c_str(), op->GetInputsSize(), op->GetOutputsSize());
 
   // checkout op input number with IR
   GE_RETURN_IF_ERROR(parser->CheckoutInputNum(op, node_def));
+  if (record_node) {
+    // Only nodes that were already unchanged since the last parse keep a copy of their op, a cold parse only
+    // records the node keys and pays no copy
+    parser->RecordParsedNode(node_name, std::move(node_key), (prev_record != nullptr) ? op : nullptr);
+  }
 
   if (needFusion) {
     status = RecordFusionResult(scope_graph, node_def, op);
@@ -927,6 +1124,7 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
   }
 
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG((node == nullptr), return INTERNAL_ERROR, "add node failed.");
+  PARSER_TRACE("ParseNodeDef", node_name, op->GetInputsSize(), op->GetOutputsSize());
 
   if (needFusion) {
     shared_ptr<OpParser> fusion_op_parser = factory->CreateFusionOpParser(op_type);
@@ -942,6 +1140,77 @@ Status TensorFlowModelParser::ParseNodeDef(TensorFlowModelParser *parser, ge::Co
   return SUCCESS;
 }
 
+string TensorFlowModelParser::GetNodeKey(const domi::tensorflow::NodeDef *node_def, const string &op_type) const {
+  // The attr map of a NodeDef has no stable order unless it is serialized deterministically
+  string key;
+  {
+    google::protobuf::io::StringOutputStream string_stream(&key);
+    google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+    coded_stream.SetSerializationDeterministic(true);
+    (void)node_def->SerializeToCodedStream(&coded_stream);
+  }
+  key.append("|").append(op_type);
+  key.append("|").append(std::to_string(static_cast<int32_t>(ge::GetParserContext().format)));
+  key.append("|").append(std::to_string(static_cast<int32_t>(ge::GetParserContext().train_flag)));
+
+  auto iter = op_node_context_map_.find(node_def->name());
+  if (iter != op_node_context_map_.end()) {
+    for (const auto &input : iter->second.input_map) {
+      key.append("|in:").append(input.first);
+      for (const auto &index : input.second) {
+        key.append(",").append(std::to_string(index.first)).append(":").append(std::to_string(index.second));
+      }
+    }
+    for (const auto &output : iter->second.output_map) {
+      key.append("|out:").append(output.first);
+      for (const auto &index : output.second) {
+        key.append(",").append(std::to_string(index.first)).append(":").append(std::to_string(index.second));
+      }
+    }
+  }
+  return key;
+}
+
+const IncrementalNodeRecord *TensorFlowModelParser::FindUnchangedNode(const string &node_name,
+                                                                      const string &node_key) const {
+  if (prev_node_records_ == nullptr) {
+    return nullptr;
+  }
+  auto iter = prev_node_records_->find(node_name);
+  if ((iter == prev_node_records_->end()) || (iter->second.key != node_key)) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+ge::OpDescPtr TensorFlowModelParser::ReuseRecordedOp(const string &node_name, const IncrementalNodeRecord &record) {
+  if (record.op_desc == nullptr) {
+    return nullptr;
+  }
+  // The recorded op stays untouched, later stages of the parse modify the copy added to the graph
+  ge::OpDescPtr op_desc = ge::AttrUtils::CloneOpDesc(record.op_desc);
+  if (op_desc == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(nodeRecordsMutex_);
+  cur_node_records_[node_name] = record;
+  return op_desc;
+}
+
+void TensorFlowModelParser::RecordParsedNode(const string &node_name, string node_key,
+                                             const ge::OpDescPtr &op_desc) {
+  IncrementalNodeRecord record;
+  record.key = std::move(node_key);
+  if (op_desc != nullptr) {
+    record.op_desc = ge::AttrUtils::CloneOpDesc(op_desc);
+    if (record.op_desc == nullptr) {
+      GELOGW("Copy op %s for incremental parse failed, it will be parsed again next time.", node_name.c_str());
+    }
+  }
+  std::lock_guard<std::mutex> lock(nodeRecordsMutex_);
+  cur_node_records_[node_name] = std::move(record);
+}
+
 Status TensorFlowModelParser::AdaptOpType(const domi::tensorflow::NodeDef *node_def, bool isDatasetInit) {
   // The caller guarantees that the pointer is not null
   string node_name = node_def->name();
@@ -1034,12 +1303,11 @@ Status TensorFlowModelParser::ExcuteScopeFusionPasses(domi::tensorflow::GraphDef
                                                       shared_ptr<ge::ScopeGraph> &scope_graph) {
   // Identifying scope fusion operators based on scope rules
   GE_CHECK_NOTNULL(graph_def);
+  // Custom op plugins deferred by the plugin manifest are loaded before anything looks up the op types
+  for (int i = 0; i < graph_def->node_size(); ++i) {
+    (void)TBEPluginLoader::Instance().LoadPluginOfOpType(graph_def->node(i).op());
+  }
   ScopePassManager passmanager;
-  PARSER_TIMESTAMP_START(BuildScopeGraph);
-  scope_graph = passmanager.BuildScopeGraph(graph_def);
-  GE_CHECK_NOTNULL(scope_graph);
-  PARSER_TIMESTAMP_END(BuildScopeGraph, "TensorFlowModelParser::BuildScopeGraph");
-  PARSER_TIMESTAMP_START(ScopeGraphPass);
   // Validate the non-general scope fusion pass.
   // The parameter is set to the name of the fusion rule.
   // Multiple names can be set and separated by ",".
@@ -1055,11 +1323,36 @@ Status TensorFlowModelParser::ExcuteScopeFusionPasses(domi::tensorflow::GraphDef
     if (enable_pass_names[i].empty()) {
       continue;
     }
-    if (!impl->SetPassEnableFlag(enable_pass_names[i], true)) {
+    bool enabled = impl->SetPassEnableFlag(enable_pass_names[i], true);
+    if (!enabled) {
+      // The pass may come with a deferred plugin
+      TBEPluginLoader::Instance().LoadAllPlugins();
+      enabled = impl->SetPassEnableFlag(enable_pass_names[i], true);
+    }
+    if (!enabled) {
       GELOGW("Failed to set enable flag of scope fusion pass:%s", enable_pass_names[i].c_str());
     }
   }
   std::vector<std::string> scope_passes_list = impl->GetAllRegisteredPasses();
+  // Passes match the sub scopes of the root scope, which only exist for node names with a '/'
+  bool has_sub_scope = false;
+  for (int i = 0; (i < graph_def->node_size()) && !has_sub_scope; ++i) {
+    has_sub_scope = (graph_def->node(i).name().find('/') != std::string::npos);
+  }
+  if (scope_passes_list.empty() || !has_sub_scope) {
+    // Nothing can match, skip building scope trees for every node of the graph
+    GELOGI("%zu scope fusion passes are enabled, graph has sub scopes: %d, skip building scope graph.",
+           scope_passes_list.size(), static_cast<int>(has_sub_scope));
+    scope_graph = passmanager.BuildEmptyScopeGraph();
+    GE_CHECK_NOTNULL(scope_graph);
+    return SUCCESS;
+  }
+
+  PARSER_TIMESTAMP_START(BuildScopeGraph);
+  scope_graph = passmanager.BuildScopeGraph(graph_def);
+  GE_CHECK_NOTNULL(scope_graph);
+  PARSER_TIMESTAMP_END(BuildScopeGraph, "TensorFlowModelParser::BuildScopeGraph");
+  PARSER_TIMESTAMP_START(ScopeGraphPass);
   Status ret = RunScopeFusionPass(scope_passes_list, passmanager, scope_graph);
   if (ret != SUCCESS) {
     GELOGE(ret, "Run scope fusion failed, ret:%u.", ret);
@@ -1071,6 +1364,7 @@ Status TensorFlowModelParser::ExcuteScopeFusionPasses(domi::tensorflow::GraphDef
 }
 
 Status TensorFlowModelParser::ParseFromMemory(const char *data, uint32_t size, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(data);
   GE_CHECK_NOTNULL(graph);
 
@@ -1192,10 +1486,14 @@ Status TensorFlowModelParser::ParseFromMemory(const char *data, uint32_t size, g
   return SUCCESS;
 }
 
+string TensorFlowModelParser::GetFunctionLibraryPath(const string &file) {
+  int pos = file.rfind('/');
+  return (pos == -1) ? kFuncDefLibraryFilePath : file.substr(0, pos) + "/" + kFuncDefLibraryFilePath;
+}
+
 Status TensorFlowModelParser::GetFunctionProto(const string &file,
                                                domi::tensorflow::GraphDefLibrary &graph_def_library) {
-  int pos = file.rfind('/');
-  string graph_def_path = (pos == -1) ? kFuncDefLibraryFilePath : file.substr(0, pos) + "/" + kFuncDefLibraryFilePath;
+  string graph_def_path = GetFunctionLibraryPath(file);
   GELOGI("Function def libraray path is %s.", graph_def_path.c_str());
 
   bool read = ge::parser::ReadProtoFromText(graph_def_path.c_str(), &graph_def_library);
@@ -1213,6 +1511,7 @@ Status TensorFlowModelParser::GetFunctionProto(const string &file,
 }
 
 Status TensorFlowModelParser::Parse(const char *model_path, ge::Graph &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(model_path);
   ge::ComputeGraphPtr root_graph = ge::GraphUtils::GetComputeGraph(graph);
   GE_CHECK_NOTNULL(root_graph);
@@ -1228,14 +1527,17 @@ Status TensorFlowModelParser::Parse(const char *model_path, ge::Graph &graph) {
 }
 
 Status TensorFlowModelParser::Parse(const char *model_path, ge::ComputeGraphPtr &root_graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(model_path);
   GE_CHECK_NOTNULL(root_graph);
 
   GELOGI("Parse file %s", model_path);
   // Store objects parsed from pb files
+  PARSER_TIMESTAMP_START(ReadModel);
   domi::tensorflow::GraphDef ori_def;
   bool read = ge::parser::ReadProtoFromBinaryFile(model_path, &ori_def);
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(!read, return INTERNAL_ERROR, "read_proto_from_binary failed.");
+  PARSER_TIMESTAMP_END(ReadModel, "TensorFlowModelParser::ReadModel");
 
   // Trim graph by user input and output.
   domi::tensorflow::GraphDef graph_def;
@@ -1254,42 +1556,50 @@ Status TensorFlowModelParser::Parse(const char *model_path, ge::ComputeGraphPtr
 
   // Get sub graph from graph_def_library.pbtxt which prepared before and stored in model_path.
   std::map<std::string, domi::tensorflow::GraphDef> function_name_to_graphdef;
+  // Each function body is parsed once, further call sites copy the parsed graph
+  ParsedFunctions parsed_functions;
 
   // Parse all root graph and sub graph.
   while (!tasks.empty()) {
     auto arg = tasks.front();
     tasks.pop_front();
 
-    if (arg.proto == nullptr) {
-      if (function_name_to_graphdef.empty() && (ori_def.library().function_size() > 0)) {
-        GELOGI("Graph has function size: %d ", ori_def.library().function_size());
-        domi::tensorflow::GraphDefLibrary graph_def_library;
-        GE_CHK_STATUS_RET(GetFunctionProto(model_path, graph_def_library));
-        for (auto &ge_graph_def : graph_def_library.graph_def()) {
-          function_name_to_graphdef[ge_graph_def.name()] = ge_graph_def.graph();
-          GELOGD("Graph_def name: %s, node size: %d", ge_graph_def.name().c_str(), ge_graph_def.graph().node_size());
+    bool copied = false;
+    GE_CHK_STATUS_RET(CopyParsedFunction(parsed_functions, arg, copied));
+    if (!copied) {
+      if (arg.proto == nullptr) {
+        if (function_name_to_graphdef.empty() && (ori_def.library().function_size() > 0)) {
+          GELOGI("Graph has function size: %d ", ori_def.library().function_size());
+          domi::tensorflow::GraphDefLibrary graph_def_library;
+          GE_CHK_STATUS_RET(GetFunctionProto(model_path, graph_def_library));
+          for (auto &ge_graph_def : graph_def_library.graph_def()) {
+            function_name_to_graphdef[ge_graph_def.name()] = ge_graph_def.graph();
+            GELOGD("Graph_def name: %s, node size: %d", ge_graph_def.name().c_str(),
+                   ge_graph_def.graph().node_size());
+          }
         }
-      }
 
-      auto iter = function_name_to_graphdef.find(arg.function_name);
-      if (iter == function_name_to_graphdef.end()) {
-        ErrorManager::GetInstance().ATCReportErrMessage("E12013", {"functionname"}, {arg.function_name});
-        GELOGE(FAILED, "Failed to get subgraph by function name %s", arg.function_name.c_str());
-        return FAILED;
+        auto iter = function_name_to_graphdef.find(arg.function_name);
+        if (iter == function_name_to_graphdef.end()) {
+          ErrorManager::GetInstance().ATCReportErrMessage("E12013", {"functionname"}, {arg.function_name});
+          GELOGE(FAILED, "Failed to get subgraph by function name %s", arg.function_name.c_str());
+          return FAILED;
+        }
+        arg.proto = &(iter->second);
       }
-      arg.proto = &(iter->second);
-    }
 
-    GELOGI("Begin to parse graph %s", arg.function_name.c_str());
-    auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::FrameworkType::TENSORFLOW);
-    auto ret = model_parser->ParseAllGraph(arg.proto, arg.graph);
-    if (ret != SUCCESS) {
-      GELOGE(ret, "Failed to parse graph %s, instance name %s", arg.function_name.c_str(),
-             arg.graph->GetName().c_str());
-      return ret;
+      GELOGI("Begin to parse graph %s", arg.function_name.c_str());
+      auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::FrameworkType::TENSORFLOW);
+      auto ret = model_parser->ParseAllGraph(arg.proto, arg.graph);
+      if (ret != SUCCESS) {
+        GELOGE(ret, "Failed to parse graph %s, instance name %s", arg.function_name.c_str(),
+               arg.graph->GetName().c_str());
+        return ret;
+      }
+      GE_CHK_STATUS_RET(RecordParsedFunction(arg, parsed_functions));
     }
 
-    ret = PostOpProcessForSubgraph(arg);
+    auto ret = PostOpProcessForSubgraph(arg);
     if (ret != SUCCESS) {
       // the error log has been printed inner the function
       return ret;
@@ -1306,6 +1616,7 @@ Status TensorFlowModelParser::Parse(const char *model_path, ge::ComputeGraphPtr
 }
 
 Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *proto, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(proto);
   GE_CHECK_NOTNULL(graph);
 
@@ -1324,6 +1635,11 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
   GE_RETURN_IF_ERROR(OptimizeConstNodes4CustomOp(&graph_def));
   GELOGD("[TF Parse] optimize const nodes for custom op base success");
 
+  PARSER_TIMESTAMP_START(RemoveDeadNodes);
+  GE_RETURN_IF_ERROR(RemoveDeadNodes(scope_graph, &graph_def));
+  PARSER_TIMESTAMP_END(RemoveDeadNodes, "TensorFlowModelParser::RemoveDeadNodes");
+  GE_RETURN_IF_ERROR(FoldStaticShapes(scope_graph, &graph_def));
+
   // Add nodedef in the model to prechecker and check the general parameters
   // Prevent data residue in multiple calls
   PreChecker::Instance().Clear();
@@ -1343,6 +1659,7 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
   bool has_error = false;
   // save node name
   vector<string> op_node_name_list;
+  PARSER_TIMESTAMP_START(AddFmkNodeDefToMap);
   for (int i = 0; i < graph_def.node_size(); i++) {
     const domi::tensorflow::NodeDef *node_def = graph_def.mutable_node(i);
 
@@ -1354,6 +1671,7 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
     // Do not exit immediately when there is an error, wait until all errors are collected before exiting
     GE_CHK_STATUS_EXEC(AddFmkNodeDefToMap(graph_def, node_def, op_node_name_list), has_error = true);
   }
+  PARSER_TIMESTAMP_END(AddFmkNodeDefToMap, "TensorFlowModelParser::AddFmkNodeDefToMap");
 
   // Verify the validity of fusionop
   GE_RETURN_IF_ERROR(CheckFusionOpValid());
@@ -1370,6 +1688,7 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
   GELOGD("[TF Parse] check graph success");
 
   // Building input and input relationships for all OP nodes
+  PARSER_TIMESTAMP_START(BuildOpContext);
   GE_RETURN_IF_ERROR(GetOpNodesContextFromGraph(graph_def));
   GELOGD("[TF Parse] get op nodes context from graph success");
 
@@ -1380,6 +1699,7 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
   // Building input-output relationship between fusionop and common op
   GE_RETURN_IF_ERROR(UpdateAllNodeOpContext(scope_graph, graph_def, op_node_name_list));
   GELOGD("[TF Parse] update all node op context success");
+  PARSER_TIMESTAMP_END(BuildOpContext, "TensorFlowModelParser::BuildOpContext");
 
   // set user-designate-inputs-order
   std::vector<std::string> user_inputs_order;
@@ -1397,6 +1717,7 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
   GELOGI("TF op node size = %zu.", op_node_name_list.size());
 
   // Loop analysis of op_nodes and map them to nodes in graph
+  PARSER_TIMESTAMP_START(AddNode);
   for (size_t i = 0; i < op_node_name_list.size(); i++) {
     GELOGI("TF op node name = %s.", op_node_name_list[i].c_str());
     const string op_node_name = op_node_name_list[i];
@@ -1419,13 +1740,18 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
     }
   }
 
+  PARSER_TIMESTAMP_END(AddNode, "TensorFlowModelParser::AddNode");
   GELOGD("[TF Parse] parse tf node to geop success");
 
   DeleteFuisonNodeDef();
 
+  PARSER_TIMESTAMP_START(AddEdges);
   GE_RETURN_IF_ERROR(AddEdges(graph));
+  PARSER_TIMESTAMP_END(AddEdges, "TensorFlowModelParser::AddEdges");
+  PARSER_TIMESTAMP_START(ExpandOneToManyGraph);
   Graph dest_graph = GraphUtils::CreateGraphFromComputeGraph(graph);
   GE_RETURN_IF_ERROR(ParserUtils::ExpandOneToManyGraph(dest_graph));
+  PARSER_TIMESTAMP_END(ExpandOneToManyGraph, "ParserUtils::ExpandOneToManyGraph");
   GE_RETURN_IF_ERROR(RemoveIsolateNode(graph));
   GE_RETURN_IF_ERROR(CheckAndUpdateInputDesc(graph));
   GE_RETURN_IF_ERROR(graph->TopologicalSorting());
@@ -1441,11 +1767,13 @@ Status TensorFlowModelParser::ParseAllGraph(const google::protobuf::Message *pro
 Status TensorFlowModelParser::CheckGraphDefValid(const domi::tensorflow::GraphDef &graph_def) {
   // Number of data nodes
   uint32_t data_node_count = 0;
+  string tmp_node_name;
   for (const domi::tensorflow::NodeDef &node_def : graph_def.node()) {
     // Check that all input is valid
     for (const string &node_name : node_def.input()) {
-      string tmp_node_name;
-      GE_RETURN_IF_ERROR(CheckInputNodeName(node_name, &tmp_node_name, nullptr, nullptr));
+      TfInputName input;
+      (void)TensorFlowUtil::ParseInputName(node_name, input);
+      input.AssignName(tmp_node_name);
 
       if (nodedef_map_.find(tmp_node_name) == nodedef_map_.end()) {
         ErrorManager::GetInstance().ATCReportErrMessage("E12009", {"opname", "inputopname"},
@@ -1493,13 +1821,18 @@ Status TensorFlowModelParser::GetOpNodeInputMap(const string &op_node_name,
   const domi::tensorflow::NodeDef *node_def = nodedef_map_[op_node_name];
   GE_CHECK_NOTNULL(node_def);
   int32_t input_index = 0;
-  int32_t output_index = 0;
+  string tmp_node_name;
   for (const string &input_node_name : node_def->input()) {
-    GELOGD("Get Op InputMap, node_name : %s, input node:%s", node_def->name().c_str(), input_node_name.c_str());
-    string tmp_node_name;
-    bool control = false;
-    GE_RETURN_IF_ERROR(CheckInputNodeName(input_node_name, &tmp_node_name, &output_index, &control));
-    input_map[tmp_node_name].push_back({output_index, control ? kControlSlot : input_index});
+    PARSER_LOGD("Get Op InputMap, node_name : %s, input node:%s", node_def->name().c_str(),
+                input_node_name.c_str());
+    TfInputName input;
+    if (!TensorFlowUtil::ParseInputName(input_node_name, input)) {
+      // reports the invalid index
+      GE_RETURN_IF_ERROR(CheckInputNodeName(input_node_name, &tmp_node_name, &input.index, &input.control));
+    }
+    bool control = input.control;
+    input.AssignName(tmp_node_name);
+    input_map[tmp_node_name].push_back({input.index, control ? kControlSlot : input_index});
     SaveEdgesControlInfo(node_def->name(), control);
     input_index = control ? input_index : input_index + 1;
   }
@@ -1557,38 +1890,22 @@ Status TensorFlowModelParser::GeStoi(const string &input_node_name, const string
 Status TensorFlowModelParser::CheckInputNodeName(const string &input_node_name, string *node_name, int32_t *index,
                                                  bool *control) {
   // Processing scene: input: "^fastrcnn_predictions/map/while/Identity""
-  string tmp_input_node_name = input_node_name;
-  if (tmp_input_node_name.find("^") == 0) {
-    tmp_input_node_name = tmp_input_node_name.substr(1, tmp_input_node_name.length() - 1);
-    if (control != nullptr) {
-      *control = true;
-    }
-  } else {
-    if (control != nullptr) {
-      *control = false;
-    }
+  TfInputName input;
+  bool index_valid = TensorFlowUtil::ParseInputName(input_node_name, input);
+  if (control != nullptr) {
+    *control = input.control;
   }
-
-  int32_t tmp_index = 0;
-  auto find = tmp_input_node_name.find(":");
-  if (find == string::npos) {
-    *node_name = tmp_input_node_name;
-
-    if (index == nullptr) {
-      return SUCCESS;
-    }
-    *index = tmp_index;
-
+  input.AssignName(*node_name);
+  if (index == nullptr) {
     return SUCCESS;
   }
-
-  string indexstr = tmp_input_node_name.substr(find + 1, tmp_input_node_name.length() - find - 1);
-  *node_name = tmp_input_node_name.substr(0, find);
-
-  if (index == nullptr) {
+  if (index_valid) {
+    *index = input.index;
     return SUCCESS;
   }
 
+  // Let stoi report the invalid index
+  string indexstr = input_node_name.substr(input_node_name.find(":") + 1);
   if (GeStoi(input_node_name, indexstr, index) != SUCCESS) {
     return INTERNAL_ERROR;
   }
@@ -2122,13 +2439,11 @@ Status TensorFlowModelParser::ToJson(const char *model_file, const char *json_fi
   GE_CHK_BOOL_RET_STATUS(model_file != nullptr, FAILED, "model_file is nullptr.");
   GE_CHK_BOOL_RET_STATUS(json_file != nullptr, FAILED, "json_file is nullptr.");
   domi::tensorflow::GraphDef graph_def;
-  nlohmann::json j;
 
   GE_RETURN_WITH_LOG_IF_FALSE(ge::parser::ReadProtoFromBinaryFile(model_file, &graph_def),
                               "ReadProtoFromBinaryFile failed, file:%s.", model_file);
 
-  Pb2Json::Message2Json(graph_def, kTfBlackFields, j, true);
-  return ModelSaver::SaveJsonToFile(json_file, j);
+  return ModelSaver::SaveMessageToJsonFile(json_file, graph_def, kTfBlackFields, true);
 }
 
 Status TensorFlowWeightsParser::ParseFromMemory(const char *data, uint32_t size, ge::ComputeGraphPtr &graph) {
@@ -2138,10 +2453,16 @@ Status TensorFlowWeightsParser::ParseFromMemory(const char *data, uint32_t size,
 Status TensorFlowWeightsParser::Parse(const char *file, ge::Graph &graph) { return SUCCESS; }
 
 Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto, ge::ComputeGraphPtr &graph) {
+  PluginRegistryReadScope registry_scope;
   PARSER_TIMESTAMP_START(ParseProto);
   GE_CHECK_NOTNULL(proto);
   GE_CHECK_NOTNULL(graph);
   ge::GetParserContext().train_flag = true;
+  if (incremental_parse_) {
+    prev_node_records_ =
+        TensorFlowIncrementalCache::Instance().GetRecords(incremental_graph_key_, incremental_libraries_stamp_);
+    cur_node_records_.clear();
+  }
 
   const domi::tensorflow::GraphDef *graph_def_in = reinterpret_cast<const domi::tensorflow::GraphDef *>(proto);
   // Make a copy for operation without modifying the original graph def.
@@ -2173,6 +2494,10 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
 
   GE_RETURN_IF_ERROR(GetTensorflowGraphInOutMap(graph_def));
   GE_RETURN_IF_ERROR(RemoveIsolateNode(graph_def));
+  PARSER_TIMESTAMP_START(RemoveDeadNodes);
+  GE_RETURN_IF_ERROR(RemoveDeadNodes(scope_graph, graph_def));
+  PARSER_TIMESTAMP_END(RemoveDeadNodes, "TensorFlowModelParser::RemoveDeadNodes");
+  GE_RETURN_IF_ERROR(FoldStaticShapes(scope_graph, graph_def));
 
   vector<string> op_node_name_list;
   bool isDatasetInit = false;
@@ -2209,7 +2534,9 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
   GELOGD("[TF Parser] Get op nodes context from graph success");
 
   // Building input-output relationship between fusionop and common op
+  PARSER_TIMESTAMP_START(UpdateAllNodeOpContext);
   GE_RETURN_IF_ERROR(UpdateAllNodeOpContext(scope_graph, *graph_def, op_node_name_list));
+  PARSER_TIMESTAMP_END(UpdateAllNodeOpContext, "TensorFlowModelParser::UpdateAllNodeOpContext");
 
   GELOGI("[TF Parser] TF op node size = %zu.", op_node_name_list.size());
   PARSER_TIMESTAMP_START(AddFmkNode);
@@ -2219,10 +2546,14 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
   GE_CHK_STATUS_EXEC(ret, DeleteFuisonNodeDef(); return ret, "AddFmkNode failed");
   GELOGD("[TF Parser] Add framework node success");
 
+  PARSER_TIMESTAMP_START(AddEdges);
   ret = AddEdges(graph);
+  PARSER_TIMESTAMP_END(AddEdges, "TensorFlowModelParser::AddEdges");
 
+  PARSER_TIMESTAMP_START(ExpandOneToManyGraph);
   Graph dest_graph = GraphUtils::CreateGraphFromComputeGraph(graph);
   GE_RETURN_IF_ERROR(ParserUtils::ExpandOneToManyGraph(dest_graph));
+  PARSER_TIMESTAMP_END(ExpandOneToManyGraph, "ParserUtils::ExpandOneToManyGraph");
 
   DeleteFuisonNodeDef();
   GE_CHK_STATUS_EXEC(ret, return ret, "AddEdges failed");
@@ -2240,8 +2571,9 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
 
   ge::parser::PassManager iterator_fusion_pass;
   try {
+    // The fusion only rewrites the graph it runs on, so subgraphs are fused concurrently
     (void)iterator_fusion_pass.AddPass("ParseProto::IteratorFusionPass",
-                                       new ge::IteratorFusionPass(ge::TENSORFLOW, false));
+                                       new ge::IteratorFusionPass(ge::TENSORFLOW, false), true);
   } catch (std::bad_alloc &e) {
     GELOGE(INTERNAL_ERROR, "Add pass failed, bad memory allocation occurs.");
     return INTERNAL_ERROR;
@@ -2257,6 +2589,15 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
     GELOGE(PARAM_INVALID, "Precheck has errors.");
     return PARAM_INVALID;
   }
+  if (incremental_parse_) {
+    GELOGI("[TF Parser] Record %zu parsed ops of graph %s for incremental parse.", cur_node_records_.size(),
+           graph->GetName().c_str());
+    TensorFlowIncrementalCache::Instance().UpdateRecords(
+        incremental_graph_key_, incremental_libraries_stamp_,
+        ge::parser::MakeShared<const IncrementalNodeRecords>(std::move(cur_node_records_)));
+    cur_node_records_.clear();
+    prev_node_records_ = nullptr;
+  }
   GELOGI("[TF Parser] Parse proto success.");
   PARSER_TIMESTAMP_END(ParseProto, "TensorFlowModelParser::ParseProto");
   return SUCCESS;
@@ -2264,6 +2605,7 @@ Status TensorFlowModelParser::ParseProto(const google::protobuf::Message *proto,
 
 Status TensorFlowModelParser::ParseProtoWithSubgraph(const google::protobuf::Message *root_proto,
                                                      domi::GetGraphCallback callback, ge::ComputeGraphPtr &root_graph) {
+  PluginRegistryReadScope registry_scope;
   GE_CHECK_NOTNULL(root_proto);
   GE_CHECK_NOTNULL(callback);
   GE_CHECK_NOTNULL(root_graph);
@@ -2272,31 +2614,51 @@ Status TensorFlowModelParser::ParseProtoWithSubgraph(const google::protobuf::Mes
   std::vector<std::unique_ptr<google::protobuf::Message>> proto_holder;
   std::deque<ParseArg> tasks;
   tasks.push_back({root_proto, "root", nullptr, "", root_graph});
+  // Each function body is parsed once, further call sites copy the parsed graph
+  ParsedFunctions parsed_functions;
+  // Repeated calls on slightly changed graphs only parse the changed nodes again, when the GE option
+  // incremental_parse is true
+  string incremental_parse;
+  bool incremental = (ge::GetThreadLocalContext().GetOption(ge::parser::INCREMENTAL_PARSE, incremental_parse) ==
+                      ge::GRAPH_SUCCESS) && (incremental_parse == "true");
+  string libraries_stamp = incremental ? ge::parser::GetLibrariesStamp() : "";
 
   while (!tasks.empty()) {
     auto arg = tasks.front();
     tasks.pop_front();
 
-    if (arg.proto == nullptr) {
-      auto proto = callback(root_proto, arg.function_name);
-      if (proto == nullptr) {
-        GELOGE(FAILED, "Failed to get function by name %s", arg.function_name.c_str());
-        return FAILED;
+    bool copied = false;
+    GE_CHK_STATUS_RET(CopyParsedFunction(parsed_functions, arg, copied));
+    if (!copied) {
+      if (arg.proto == nullptr) {
+        auto proto = callback(root_proto, arg.function_name);
+        if (proto == nullptr) {
+          GELOGE(FAILED, "Failed to get function by name %s", arg.function_name.c_str());
+          return FAILED;
+        }
+        arg.proto = proto.get();
+        proto_holder.emplace_back(std::move(proto));
       }
-      arg.proto = proto.get();
-      proto_holder.emplace_back(std::move(proto));
-    }
 
-    GELOGI("Begin to parse graph %s", arg.function_name.c_str());
-    auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::FrameworkType::TENSORFLOW);
-    auto ret = model_parser->ParseProto(arg.proto, arg.graph);
-    if (ret != SUCCESS) {
-      GELOGE(ret, "Failed to parse graph %s, instance name %s", arg.function_name.c_str(),
-             arg.graph->GetName().c_str());
-      return ret;
+      GELOGI("Begin to parse graph %s", arg.function_name.c_str());
+      auto model_parser = domi::ModelParserFactory::Instance()->CreateModelParser(domi::FrameworkType::TENSORFLOW);
+      GE_CHECK_NOTNULL(model_parser);
+      auto tf_model_parser = std::dynamic_pointer_cast<TensorFlowModelParser>(model_parser);
+      if (incremental && (tf_model_parser != nullptr)) {
+        tf_model_parser->incremental_parse_ = true;
+        tf_model_parser->incremental_graph_key_ = root_graph->GetName() + "/" + arg.graph->GetName();
+        tf_model_parser->incremental_libraries_stamp_ = libraries_stamp;
+      }
+      auto ret = model_parser->ParseProto(arg.proto, arg.graph);
+      if (ret != SUCCESS) {
+        GELOGE(ret, "Failed to parse graph %s, instance name %s", arg.function_name.c_str(),
+               arg.graph->GetName().c_str());
+        return ret;
+      }
+      GE_CHK_STATUS_RET(RecordParsedFunction(arg, parsed_functions));
     }
 
-    ret = PostOpProcessForSubgraph(arg);
+    auto ret = PostOpProcessForSubgraph(arg);
     if (ret != SUCCESS) {
       // the error log has been printed inner the function
       return ret;
@@ -2402,15 +2764,10 @@ Status TensorFlowModelParser::OptimizeSnapShot(domi::tensorflow::NodeDef *curr_m
     GE_CHECK_NOTNULL(output_node_def);
     auto inputs = output_node_def->mutable_input();
     for (auto &input : *inputs) {
-      string node_name;
-      bool is_control = false;
-      if (CheckInputNodeName(input, &node_name, nullptr, &is_control) != SUCCESS) {
-        GELOGE(FAILED, "parse node input info failed, node %s, input %s.", output_node_def->name().c_str(),
-               input.c_str());
-        return FAILED;
-      }
-      if (node_name == curr_node_name) {
-        if (is_control) {
+      TfInputName input_name;
+      (void)TensorFlowUtil::ParseInputName(input, input_name);
+      if (input_name.NameEquals(curr_node_name)) {
+        if (input_name.control) {
           input = "^" + input_data.first;
         } else if (input_data.second == 0) {
           input = input_data.first;
@@ -2422,13 +2779,9 @@ Status TensorFlowModelParser::OptimizeSnapShot(domi::tensorflow::NodeDef *curr_m
         for (auto &item : control_list) {
           bool is_exist_input = false;
           for (auto &tmp_input : output_node_def->input()) {
-            string tmp_node_name;
-            if (CheckInputNodeName(tmp_input, &tmp_node_name, nullptr, nullptr) != SUCCESS) {
-              GELOGE(INTERNAL_ERROR, "parse node input info failed, node %s, input %s.",
-                     output_node_def->name().c_str(), tmp_input.c_str());
-              return FAILED;
-            }
-            if (tmp_node_name == item) {
+            TfInputName tmp_input_name;
+            (void)TensorFlowUtil::ParseInputName(tmp_input, tmp_input_name);
+            if (tmp_input_name.NameEquals(item)) {
               is_exist_input = true;
               break;
             }
@@ -2500,17 +2853,12 @@ void TensorFlowModelParser::OptimizeDestroyTemporaryVariable(domi::tensorflow::G
     domi::tensorflow::NodeDef *nodeDst = graph_def->mutable_node(w);
     GE_IF_BOOL_EXEC(nodeDst->name() == nodeCurrent->name(), continue);
     for (int k = 0; k < nodeDst->input_size(); k++) {
-      string nodeDstInputName = nodeDst->input(k);
-      string nodeDstInputNameTmp;
-      bool isControl = false;
-      if (CheckInputNodeName(nodeDstInputName, &nodeDstInputNameTmp, nullptr, &isControl) != SUCCESS) {
-        GELOGE(FAILED, "CheckInputNodeName failed, node is: %s", nodeDstInputName.c_str());
-        return;
-      }
-      if (nodeDstInputNameTmp == nodeCurrent->name()) {
+      TfInputName nodeDstInputName;
+      (void)TensorFlowUtil::ParseInputName(nodeDst->input(k), nodeDstInputName);
+      if (nodeDstInputName.NameEquals(nodeCurrent->name())) {
         GELOGI("current node name is %s ", nodeCurrent->name().c_str());
         clearInputFlag = true;
-        if (isControl) {
+        if (nodeDstInputName.control) {
           string nodeCurrentName = nodeCurrent->input(0);
           string nodeCurrentNameTmp;
           if (CheckInputNodeName(nodeCurrentName, &nodeCurrentNameTmp, nullptr, nullptr) != SUCCESS) {
@@ -3049,15 +3397,9 @@ Status TensorFlowModelParser::TrimGraphByOutput(const domi::tensorflow::GraphDef
   return SUCCESS;
 }
 string TensorFlowModelParser::NodeNameFromInput(const string &input_name) {
-  string prefix;
-  string node_name;
-  string suffix;
-  std::vector<string> input_parts = ge::StringUtils::Split(input_name, ':');
-  suffix = (input_parts.size() < kInputNumUint) ? "" : (":" + input_parts[1]);
-  string tmp_name = input_parts[0];
-  GE_IF_BOOL_EXEC(input_parts[0].find("^") == 0, tmp_name = tmp_name.substr(1, tmp_name.length() - 1));
-  node_name = tmp_name;
-  return node_name;
+  TfInputName input;
+  (void)TensorFlowUtil::ParseInputName(input_name, input);
+  return input.Name();
 }
 
 Status TensorFlowModelParser::FusionNodeParseParams(shared_ptr<OpParser> &op_parser,
@@ -3325,8 +3667,9 @@ Status TensorFlowModelParser::GetTensorflowGraphInOutMap(domi::tensorflow::Graph
     const string &node_name = node->name();
     node_inputs_outputs_map_.emplace(node_name, std::pair<set<string>, set<string>>{});
     for (const auto &input : node->input()) {
-      string input_node_name;
-      GE_RETURN_IF_ERROR(CheckInputNodeName(input, &input_node_name, nullptr, nullptr));
+      TfInputName input_name;
+      (void)TensorFlowUtil::ParseInputName(input, input_name);
+      string input_node_name = input_name.Name();
       node_inputs_outputs_map_[node_name].first.insert(input_node_name);
       node_inputs_outputs_map_[input_node_name].second.insert(node_name);
     }
@@ -3365,6 +3708,104 @@ Status TensorFlowModelParser::RemoveIsolateNode(domi::tensorflow::GraphDef *grap
   return SUCCESS;
 }
 
+bool TensorFlowModelParser::IsFusionScopeNode(const shared_ptr<ge::ScopeGraph> &scope_graph, const string &node_name) {
+  ge::ScopeFusionOpInfo info;
+  std::vector<ge::ScopeFusionOpInfo> info_list;
+  return TensorFlowFunsionOPUtil::MaybeFusionOp(node_name, &info) ||
+         ((scope_graph != nullptr) && scope_graph->impl_->IsFusionOpChild(node_name, info_list));
+}
+
+Status TensorFlowModelParser::RemoveDeadNodes(const shared_ptr<ge::ScopeGraph> &scope_graph,
+                                              domi::tensorflow::GraphDef *graph_def) {
+  GE_CHECK_NOTNULL(graph_def);
+  const int node_size = graph_def->node_size();
+  std::unordered_map<string, int> node_index;
+  node_index.reserve(static_cast<size_t>(node_size));
+  bool has_output = false;
+  for (int i = 0; i < node_size; i++) {
+    const domi::tensorflow::NodeDef &node = graph_def->node(i);
+    node_index.emplace(node.name(), i);
+    has_output = has_output || (node.op() == kRetvalOpType);
+  }
+  const ge::ParserContext &ctx = ge::GetParserContext();
+  if (!has_output) {
+    for (const auto &out_node : ctx.out_nodes_map) {
+      if (node_index.count(out_node.first) == 0) {
+        GELOGI("[TF Parser] Out node %s is not in the graph, keep all nodes.", out_node.first.c_str());
+        return SUCCESS;
+      }
+    }
+    has_output = !ctx.out_nodes_map.empty();
+  }
+  if (!has_output) {
+    return SUCCESS;
+  }
+
+  std::vector<bool> live(static_cast<size_t>(node_size), false);
+  std::vector<int> to_visit;
+  auto mark_live = [&live, &to_visit](int index) {
+    if (!live[index]) {
+      live[index] = true;
+      to_visit.push_back(index);
+    }
+  };
+  for (int i = 0; i < node_size; i++) {
+    const domi::tensorflow::NodeDef &node = graph_def->node(i);
+    if ((kPureOpTypes.count(node.op()) == 0) || (ctx.out_nodes_map.count(node.name()) > 0) ||
+        (ctx.input_dims.count(node.name()) > 0)) {
+      mark_live(i);
+      continue;
+    }
+    // Scope fusion results refer to their nodes by name, so nodes inside a fusion scope are kept
+    if (IsFusionScopeNode(scope_graph, node.name())) {
+      mark_live(i);
+    }
+  }
+  // Walk data and control inputs back from the live roots
+  while (!to_visit.empty()) {
+    int index = to_visit.back();
+    to_visit.pop_back();
+    for (const auto &input : graph_def->node(index).input()) {
+      auto iter = node_index.find(NodeNameFromInput(input));
+      if (iter != node_index.end()) {
+        mark_live(iter->second);
+      }
+    }
+  }
+
+  // Compact the live nodes to the front in their original order, then drop the rest at once
+  int live_num = 0;
+  for (int i = 0; i < node_size; i++) {
+    if (!live[i]) {
+      PARSER_LOGD("Node %s reaches no output, remove it.", graph_def->node(i).name().c_str());
+      continue;
+    }
+    if (live_num != i) {
+      graph_def->mutable_node()->SwapElements(live_num, i);
+    }
+    live_num++;
+  }
+  if (live_num < node_size) {
+    graph_def->mutable_node()->DeleteSubrange(live_num, node_size - live_num);
+    GELOGI("[TF Parser] Removed %d dead nodes, %d nodes left.", node_size - live_num, live_num);
+  }
+  return SUCCESS;
+}
+
+Status TensorFlowModelParser::FoldStaticShapes(const shared_ptr<ge::ScopeGraph> &scope_graph,
+                                               domi::tensorflow::GraphDef *graph_def) {
+  if (!ge::parser::GetParseOptions().shape_folding) {
+    return SUCCESS;
+  }
+  PARSER_TIMESTAMP_START(FoldStaticShapes);
+  // Scope fusion results refer to their nodes by name, so nodes inside a fusion scope are not folded
+  TensorFlowShapeFolding shape_folding(
+      graph_def, [&scope_graph](const string &node_name) { return IsFusionScopeNode(scope_graph, node_name); });
+  GE_RETURN_IF_ERROR(shape_folding.Run());
+  PARSER_TIMESTAMP_END(FoldStaticShapes, "TensorFlowModelParser::FoldStaticShapes");
+  return SUCCESS;
+}
+
 Status TensorFlowModelParser::RecordFusionResult(std::shared_ptr<ge::ScopeGraph> &scope_graph,
                                                  const domi::tensorflow::NodeDef *node, ge::OpDescPtr &op_desc) {
   // The caller guarantees that the pointer is not null
@@ -3728,18 +4169,18 @@ Status TensorFlowModelParser::AddScopeInnerNode(TensorFlowModelParser *parser, g
 }
 
 void TensorFlowModelParser::DumpNodeContext(const string &node_name, const OpNodeContext &ctx, const string &phase) {
-  GELOGD("phase:%s === Begin to dump context for node:%s ===", phase.c_str(), node_name.c_str());
+  PARSER_LOGD("phase:%s === Begin to dump context for node:%s ===", phase.c_str(), node_name.c_str());
   for (const auto &input : ctx.input_map) {
     for (const auto &input_idx : input.second) {
-      GELOGD("  Input info: %s:%d --> in_idx %d.", input.first.c_str(), input_idx.first, input_idx.second);
+      PARSER_LOGD("  Input info: %s:%d --> in_idx %d.", input.first.c_str(), input_idx.first, input_idx.second);
     }
   }
   for (const auto &output : ctx.output_map) {
     for (const auto &output_idx : output.second) {
-      GELOGD("  Output info: out_idx %d --> %s:%d.", output_idx.first, output.first.c_str(), output_idx.second);
+      PARSER_LOGD("  Output info: out_idx %d --> %s:%d.", output_idx.first, output.first.c_str(), output_idx.second);
     }
   }
-  GELOGD("phase:%s === End to dump context for node:%s ===", phase.c_str(), node_name.c_str());
+  PARSER_LOGD("phase:%s === End to dump context for node:%s ===", phase.c_str(), node_name.c_str());
 }
 
 void TensorFlowModelParser::DumpAllNodeContext(const string &phase) {
@@ -3785,6 +4226,22 @@ Status TensorFlowModelParser::CheckAndUpdateInputDesc(ge::ComputeGraphPtr &compu
   }
   return SUCCESS;
 }
+
+size_t TensorFlowModelParser::GetScopeFusionPassCount() {
+  auto &impl = ge::ScopeFusionPassRegistry::GetInstance().impl_;
+  return (impl == nullptr) ? 0 : impl->GetAllRegisteredPasses().size();
+}
+
+namespace {
+// Lets the plugin loader keep plugins registering scope fusion passes out of the deferred plugins
+class ScopePassCounterRegistrar {
+ public:
+  ScopePassCounterRegistrar() {
+    TBEPluginLoader::Instance().SetScopePassCounter(&TensorFlowModelParser::GetScopeFusionPassCount);
+  }
+};
+ScopePassCounterRegistrar g_scope_pass_counter_registrar;
+}  // namespace
 }  // namespace ge
 
 namespace domi {
@@ -38,6 +38,7 @@
 #include "omg/parser/weights_parser.h"
 #include "parser/tensorflow/tensorflow_fusion_op_parser.h"
 #include "parser/tensorflow/tensorflow_fusionop_util.h"
+#include "parser/tensorflow/tensorflow_incremental_cache.h"
 #include "parser/tensorflow/tensorflow_util.h"
 #include "proto/om.pb.h"
 #include "proto/tensorflow/graph.pb.h"
@@ -73,6 +74,24 @@ struct OpNodeContext {
   std::map<std::string, std::vector<std::pair<int32_t, int32_t>>> output_map;
 };
 
+// Edge from an op node to one input of dest, resolved before any anchor is linked
+struct OpNodeEdgeLink {
+  ge::NodePtr dest;
+  int32_t src_index;
+  int32_t dest_index;
+  bool control;
+};
+
+// All edges out of one op node
+struct OpNodeEdges {
+  ge::NodePtr src;
+  bool is_switch = false;
+  std::vector<OpNodeEdgeLink> links;
+  // input_map entries of the destinations these edges consume
+  std::vector<std::pair<OpNodeContext *, std::map<std::string, std::vector<std::pair<int32_t, int32_t>>>::iterator>>
+      consumed_inputs;
+};
+
 struct DelTransposeInfo;
 class TensorFlowModelParser : public domi::ModelParser {
  public:
@@ -126,6 +145,17 @@ class TensorFlowModelParser : public domi::ModelParser {
 
   Status ParseAllGraph(const google::protobuf::Message *root_proto, ge::ComputeGraphPtr &root_graph) override ;
 
+  /**
+  * @ingroup domi_omg
+  * @brief Path of the function library read for models with function operators
+  * @param [in] file model file
+  * @return graph_def_library.pbtxt next to the model file
+  */
+  static string GetFunctionLibraryPath(const string &file);
+
+  // Number of scope fusion passes registered so far
+  static size_t GetScopeFusionPassCount();
+
  private:
   Status Parse(const char *file, ge::ComputeGraphPtr &graph);
 
@@ -176,6 +206,28 @@ class TensorFlowModelParser : public domi::ModelParser {
    */
   Status AddEdges(ge::ComputeGraphPtr &graph);
 
+  /**
+   * @ingroup domi_omg
+   * @brief Resolve the edges out of one op node by name, reads the parser maps only
+   * @param [in] src_op_name name of the source op node
+   * @param [in] src_context context of the source op node
+   * @param [out] edges edges to link
+   * @return SUCCESS resolve successfully
+   * @return FAILED resolve failed
+
+   */
+  Status ResolveOpNodeEdges(const string &src_op_name, const OpNodeContext &src_context, OpNodeEdges &edges);
+
+  /**
+   * @ingroup domi_omg
+   * @brief Link the resolved edges out of one op node and consume the matching input_map entries
+   * @param [in] edges edges to link
+   * @return SUCCESS link successfully
+   * @return FAILED link failed
+
+   */
+  Status LinkOpNodeEdges(const OpNodeEdges &edges);
+
   /**
   * @ingroup domi_omg
   * @brief get op context from the parsed graph
@@ -560,6 +612,28 @@ class TensorFlowModelParser : public domi::ModelParser {
 
   Status GetTensorflowGraphInOutMap(domi::tensorflow::GraphDef *graph_def);
   Status RemoveIsolateNode(domi::tensorflow::GraphDef *graph_def);
+
+  /**
+  * @ingroup domi_omg
+  * @brief Remove the nodes of known pure op types that reach no graph output and no node of another type.
+  *        Nodes of any other type may have side effects and are kept even without consumers.
+  *        The outputs are the _Retval nodes of a function, or the user out nodes of the root graph.
+  *        Without either, every node without consumers is an output and nothing is removed.
+  * @param [in] scope_graph nodes of fusion scopes are kept
+  * @param [inout] graph_def graph to prune
+  * @return SUCCESS
+  */
+  Status RemoveDeadNodes(const shared_ptr<ge::ScopeGraph> &scope_graph, domi::tensorflow::GraphDef *graph_def);
+
+  /**
+  * @ingroup domi_omg
+  * @brief Replace the subgraphs computing static shapes by Const nodes when the option shape_folding is true
+  * @param [in] scope_graph nodes of fusion scopes are not folded
+  * @param [inout] graph_def graph to fold
+  * @return SUCCESS
+  */
+  Status FoldStaticShapes(const shared_ptr<ge::ScopeGraph> &scope_graph, domi::tensorflow::GraphDef *graph_def);
+  static bool IsFusionScopeNode(const shared_ptr<ge::ScopeGraph> &scope_graph, const string &node_name);
   static Status RecordFusionResult(std::shared_ptr<ge::ScopeGraph> &scope_graph,
                                    const domi::tensorflow::NodeDef *node,
                                    ge::OpDescPtr &op_def);
@@ -605,6 +679,30 @@ class TensorFlowModelParser : public domi::ModelParser {
   Status ParseOpParams(const domi::tensorflow::NodeDef *node_def, ge::OpDescPtr &op, shared_ptr<OpParser> &op_parser);
   Status CheckAndUpdateInputDesc(ge::ComputeGraphPtr &compute_graph);
 
+  /**
+   * @ingroup domi_omg
+   * @brief Key of everything the op parsing of a node depends on: the NodeDef, the adapted op type,
+   *        the input/output context of the node and the parser context
+   */
+  string GetNodeKey(const domi::tensorflow::NodeDef *node_def, const string &op_type) const;
+  /**
+   * @ingroup domi_omg
+   * @brief Get the record of an identical node from the last parse of the same graph
+   * @return nullptr if the node is new or changed
+   */
+  const IncrementalNodeRecord *FindUnchangedNode(const string &node_name, const string &node_key) const;
+  /**
+   * @ingroup domi_omg
+   * @brief Get a copy of the recorded op and carry the record over to this parse
+   * @return nullptr if the node has to be parsed
+   */
+  ge::OpDescPtr ReuseRecordedOp(const string &node_name, const IncrementalNodeRecord &record);
+  /**
+   * @ingroup domi_omg
+   * @brief Record the key of a parsed node, and a copy of its op unless op_desc is nullptr
+   */
+  void RecordParsedNode(const string &node_name, string node_key, const ge::OpDescPtr &op_desc);
+
     /**
    * save <node_name, node_def>
    */
@@ -657,6 +755,17 @@ class TensorFlowModelParser : public domi::ModelParser {
   unordered_map<string, std::pair<set<string>, set<string>>> node_inputs_outputs_map_;
 
   unordered_map<string, const ge::Operator *> scope_inner_node_map_;
+
+  /**
+   * incremental parse, only enabled by ParseProtoWithSubgraph with the GE option incremental_parse.
+   * prev_node_records_ holds the ops of the last parse of this graph, cur_node_records_ collects the ops of this one.
+   */
+  bool incremental_parse_ = false;
+  string incremental_graph_key_;
+  string incremental_libraries_stamp_;
+  std::shared_ptr<const IncrementalNodeRecords> prev_node_records_;
+  IncrementalNodeRecords cur_node_records_;
+  std::mutex nodeRecordsMutex_;
 };
 
 /**
@@ -80,5 +80,5 @@ Status TensorFlowRefSwitchParser::PostParseParams(const domi::tensorflow::NodeDe
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, REFSWITCH, TensorFlowRefSwitchParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, REFSWITCH, TensorFlowRefSwitchParser);
 }  // namespace ge
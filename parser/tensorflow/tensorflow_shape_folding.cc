@@ -0,0 +1,832 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parser/tensorflow/tensorflow_shape_folding.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include "framework/common/debug/ge_log.h"
+#include "framework/omg/parser/parser_inner_ctx.h"
+#include "parser/common/parser_log.h"
+#include "parser/tensorflow/tensorflow_util.h"
+
+using domi::tensorflow::AttrValue;
+using domi::tensorflow::DataType;
+using domi::tensorflow::NodeDef;
+using domi::tensorflow::TensorProto;
+
+namespace ge {
+namespace {
+// values with more elements are not tracked, shape subgraphs are tiny
+const int64_t kMaxFoldElements = 4096;
+// operands of the folded arithmetic are bounded so that no int64 operation can overflow
+const int64_t kMaxFoldOperand = std::numeric_limits<int32_t>::max();
+const char *const kShapeNFoldedSuffix = "/shape_folded_";
+
+const std::vector<std::string> kPassThroughOps = {"Identity", "StopGradient", "Snapshot", "PreventGradient"};
+// element wise ops whose output shape is the shape of their first input
+const std::vector<std::string> kShapePreservingOps = {
+    "Relu", "Relu6", "Sigmoid", "Tanh", "Elu", "Selu", "Softplus", "Neg", "Abs", "Exp", "Log", "Sqrt", "Rsqrt",
+    "Square", "Reciprocal", "Floor", "Ceil", "Round", "ZerosLike", "OnesLike", "Softmax", "LogSoftmax"};
+const std::vector<std::string> kBinaryOps = {"Add", "AddV2", "Sub", "Mul", "FloorDiv", "FloorMod", "Maximum",
+                                             "Minimum"};
+
+bool IsOneOf(const std::string &op, const std::vector<std::string> &ops) {
+  return std::find(ops.begin(), ops.end(), op) != ops.end();
+}
+
+bool IsIntType(DataType dtype) {
+  return (dtype == domi::tensorflow::DT_INT32) || (dtype == domi::tensorflow::DT_INT64);
+}
+
+int64_t GetIntAttr(const NodeDef &node, const std::string &name, int64_t default_value) {
+  const auto it = node.attr().find(name);
+  return (it == node.attr().end()) ? default_value : it->second.i();
+}
+
+DataType GetTypeAttr(const NodeDef &node, const std::string &name, DataType default_value) {
+  const auto it = node.attr().find(name);
+  return (it == node.attr().end()) ? default_value : it->second.type();
+}
+
+int DataInputSize(const NodeDef &node) {
+  int size = 0;
+  for (const auto &input : node.input()) {
+    if (!input.empty() && (input[0] != '^')) {
+      ++size;
+    }
+  }
+  return size;
+}
+
+bool ElementCount(const std::vector<int64_t> &shape, int64_t &count) {
+  count = 1;
+  for (const int64_t dim : shape) {
+    if ((dim < 0) || ((dim > 0) && (count > std::numeric_limits<int64_t>::max() / dim))) {
+      return false;
+    }
+    count *= dim;
+  }
+  return true;
+}
+
+bool FitsType(DataType dtype, const std::vector<int64_t> &values) {
+  if (dtype == domi::tensorflow::DT_INT64) {
+    return true;
+  }
+  for (const int64_t value : values) {
+    if ((value < std::numeric_limits<int32_t>::min()) || (value > std::numeric_limits<int32_t>::max())) {
+      return false;
+    }
+  }
+  return dtype == domi::tensorflow::DT_INT32;
+}
+
+// scalar or single element tensor
+bool GetScalar(const std::vector<int64_t> &values, int64_t &value) {
+  if (values.size() != 1) {
+    return false;
+  }
+  value = values[0];
+  return true;
+}
+
+bool InOperandRange(int64_t value) {
+  return (value >= -kMaxFoldOperand) && (value <= kMaxFoldOperand);
+}
+
+bool CalcBinary(const std::string &op, int64_t lhs, int64_t rhs, int64_t &result) {
+  if (!InOperandRange(lhs) || !InOperandRange(rhs)) {
+    return false;
+  }
+  if ((op == "Add") || (op == "AddV2")) {
+    result = lhs + rhs;
+  } else if (op == "Sub") {
+    result = lhs - rhs;
+  } else if (op == "Mul") {
+    result = lhs * rhs;
+  } else if (op == "Maximum") {
+    result = std::max(lhs, rhs);
+  } else if (op == "Minimum") {
+    result = std::min(lhs, rhs);
+  } else if (rhs == 0) {
+    return false;
+  } else if (op == "FloorDiv") {
+    result = lhs / rhs;
+    if ((lhs % rhs != 0) && ((lhs < 0) != (rhs < 0))) {
+      --result;
+    }
+  } else {
+    result = lhs % rhs;
+    if ((result != 0) && ((result < 0) != (rhs < 0))) {
+      result += rhs;
+    }
+  }
+  return true;
+}
+
+bool SetShapeValue(const std::vector<int64_t> &shape, DataType dtype, std::vector<int64_t> &values) {
+  values = shape;
+  return IsIntType(dtype) && FitsType(dtype, values);
+}
+}  // namespace
+
+Status TensorFlowShapeFolding::Run() {
+  GE_CHECK_NOTNULL(graph_def_);
+  const int node_size = graph_def_->node_size();
+  node_index_.clear();
+  node_index_.reserve(node_size);
+  for (int i = 0; i < node_size; ++i) {
+    node_index_.emplace(graph_def_->node(i).name(), i);
+  }
+  outputs_.assign(node_size, std::vector<FoldValue>());
+
+  std::vector<int> order;
+  SortNodes(order);
+  for (const int index : order) {
+    EvalNode(index);
+  }
+  const int folded = ReplaceFoldedNodes();
+  GELOGI("[TF Parser] Shape folding replaced %d nodes by Const, node size %d -> %d.", folded, node_size,
+         graph_def_->node_size());
+  return SUCCESS;
+}
+
+void TensorFlowShapeFolding::SortNodes(std::vector<int> &order) const {
+  const int node_size = graph_def_->node_size();
+  std::vector<int> in_degree(node_size, 0);
+  std::vector<std::vector<int>> consumers(node_size);
+  TfInputName input_name;
+  std::string name;
+  for (int i = 0; i < node_size; ++i) {
+    for (const auto &input : graph_def_->node(i).input()) {
+      if (!TensorFlowUtil::ParseInputName(input, input_name)) {
+        continue;
+      }
+      input_name.AssignName(name);
+      const auto it = node_index_.find(name);
+      if (it != node_index_.end()) {
+        consumers[it->second].push_back(i);
+        ++in_degree[i];
+      }
+    }
+  }
+
+  // nodes in cycles, e.g. loop bodies, never reach a zero in degree and are not evaluated
+  order.clear();
+  order.reserve(node_size);
+  for (int i = 0; i < node_size; ++i) {
+    if (in_degree[i] == 0) {
+      order.push_back(i);
+    }
+  }
+  for (size_t pos = 0; pos < order.size(); ++pos) {
+    for (const int consumer : consumers[order[pos]]) {
+      if (--in_degree[consumer] == 0) {
+        order.push_back(consumer);
+      }
+    }
+  }
+}
+
+const TensorFlowShapeFolding::FoldValue *TensorFlowShapeFolding::GetInput(const NodeDef &node,
+                                                                         int input_index) const {
+  if ((input_index < 0) || (input_index >= node.input_size())) {
+    return nullptr;
+  }
+  TfInputName input_name;
+  if (!TensorFlowUtil::ParseInputName(node.input(input_index), input_name) || input_name.control) {
+    return nullptr;
+  }
+  const auto it = node_index_.find(input_name.Name());
+  if (it == node_index_.end()) {
+    return nullptr;
+  }
+  const auto &outputs = outputs_[it->second];
+  if ((input_name.index < 0) || (static_cast<size_t>(input_name.index) >= outputs.size())) {
+    return nullptr;
+  }
+  return &outputs[input_name.index];
+}
+
+void TensorFlowShapeFolding::EvalNode(int index) {
+  const NodeDef &node = graph_def_->node(index);
+  const std::string &op = node.op();
+  std::vector<FoldValue> &outputs = outputs_[index];
+  if (op == "ShapeN") {
+    const int64_t num = GetIntAttr(node, "N", DataInputSize(node));
+    if ((num <= 0) || (num > node.input_size())) {
+      return;
+    }
+    const DataType dtype = GetTypeAttr(node, "out_type", domi::tensorflow::DT_INT32);
+    outputs.resize(num);
+    for (int64_t i = 0; i < num; ++i) {
+      const FoldValue *input = GetInput(node, static_cast<int>(i));
+      FoldValue &out = outputs[i];
+      if ((input != nullptr) && input->has_shape) {
+        out.has_shape = true;
+        out.shape.push_back(static_cast<int64_t>(input->shape.size()));
+        out.has_value = SetShapeValue(input->shape, dtype, out.values);
+        out.dtype = dtype;
+        out.from_shape = true;
+      }
+    }
+    return;
+  }
+
+  outputs.resize(1);
+  FoldValue &out = outputs[0];
+  const FoldValue *input = GetInput(node, 0);
+  bool ok = false;
+  if (op == "Const") {
+    ok = EvalConst(node, out);
+  } else if ((op == "Placeholder") || (op == "PlaceholderV2")) {
+    ok = EvalPlaceholder(node, out);
+  } else if (IsOneOf(op, kPassThroughOps)) {
+    ok = (input != nullptr);
+    if (ok) {
+      out = *input;
+    }
+  } else if (IsOneOf(op, kShapePreservingOps)) {
+    ok = (input != nullptr) && input->has_shape;
+    if (ok) {
+      out.has_shape = true;
+      out.shape = input->shape;
+    }
+  } else if (op == "Cast") {
+    ok = (input != nullptr) && input->has_shape;
+    if (ok) {
+      out.has_shape = true;
+      out.shape = input->shape;
+      const DataType dtype = GetTypeAttr(node, "DstT", domi::tensorflow::DT_INVALID);
+      if (input->has_value && FitsType(dtype, input->values)) {
+        out.has_value = true;
+        out.dtype = dtype;
+        out.values = input->values;
+        out.from_shape = input->from_shape;
+      }
+    }
+  } else if ((op == "Shape") || (op == "Size") || (op == "Rank")) {
+    ok = (input != nullptr) && input->has_shape;
+    if (ok) {
+      const DataType dtype = (op == "Rank") ? domi::tensorflow::DT_INT32
+                                            : GetTypeAttr(node, "out_type", domi::tensorflow::DT_INT32);
+      int64_t count = 0;
+      if (op == "Shape") {
+        out.has_value = SetShapeValue(input->shape, dtype, out.values);
+      } else if (op == "Size") {
+        out.has_value = ElementCount(input->shape, count) && SetShapeValue({count}, dtype, out.values);
+      } else {
+        out.has_value = SetShapeValue({static_cast<int64_t>(input->shape.size())}, dtype, out.values);
+      }
+      out.dtype = dtype;
+      out.from_shape = true;
+      out.has_shape = true;
+      out.shape.clear();
+      if (op == "Shape") {
+        out.shape.push_back(static_cast<int64_t>(input->shape.size()));
+      }
+    }
+  } else if (op == "StridedSlice") {
+    ok = EvalStridedSlice(node, out);
+  } else if (op == "Pack") {
+    ok = EvalPack(node, out);
+  } else if (op == "ConcatV2") {
+    ok = EvalConcat(node, out);
+  } else if (IsOneOf(op, kBinaryOps)) {
+    ok = EvalBinary(node, out);
+  } else if (op == "Prod") {
+    ok = EvalProd(node, out);
+  } else if ((op == "GatherV2") || (op == "Gather")) {
+    ok = EvalGather(node, out);
+  } else if (op == "Reshape") {
+    ok = EvalReshape(node, out);
+  }
+
+  int64_t count = 0;
+  if (!ok || (out.has_shape && !ElementCount(out.shape, count))) {
+    // unknown, later nodes treat it as a dynamic input
+    out = FoldValue();
+  } else if (out.has_value && (!out.has_shape || (static_cast<size_t>(count) != out.values.size()) ||
+                               (count > kMaxFoldElements))) {
+    out.has_value = false;
+    out.values.clear();
+  }
+}
+
+bool TensorFlowShapeFolding::EvalConst(const NodeDef &node, FoldValue &out) const {
+  const auto it = node.attr().find("value");
+  if ((it == node.attr().end()) || !it->second.has_tensor()) {
+    return false;
+  }
+  const TensorProto &tensor = it->second.tensor();
+  if (tensor.tensor_shape().unknown_rank()) {
+    return false;
+  }
+  for (const auto &dim : tensor.tensor_shape().dim()) {
+    out.shape.push_back(dim.size());
+  }
+  int64_t count = 0;
+  if (!ElementCount(out.shape, count)) {
+    return false;
+  }
+  out.has_shape = true;
+  const DataType dtype = tensor.dtype();
+  if ((count > kMaxFoldElements) || !IsIntType(dtype)) {
+    // large or non integer constants only provide their shape
+    return true;
+  }
+
+  out.dtype = dtype;
+  out.values.reserve(count);
+  const bool is_int32 = (dtype == domi::tensorflow::DT_INT32);
+  if (!tensor.tensor_content().empty()) {
+    const size_t elem_size = is_int32 ? sizeof(int32_t) : sizeof(int64_t);
+    const std::string &content = tensor.tensor_content();
+    if (content.size() != static_cast<size_t>(count) * elem_size) {
+      return true;
+    }
+    for (int64_t i = 0; i < count; ++i) {
+      if (is_int32) {
+        int32_t value = 0;
+        (void)std::memcpy(&value, content.data() + i * elem_size, elem_size);
+        out.values.push_back(value);
+      } else {
+        int64_t value = 0;
+        (void)std::memcpy(&value, content.data() + i * elem_size, elem_size);
+        out.values.push_back(value);
+      }
+    }
+  } else {
+    // like tensorflow, missing trailing elements repeat the last given one, an empty list means zeros
+    const int val_size = is_int32 ? tensor.int_val_size() : tensor.int64_val_size();
+    if (val_size > count) {
+      return true;
+    }
+    for (int64_t i = 0; i < count; ++i) {
+      if (val_size == 0) {
+        out.values.push_back(0);
+        continue;
+      }
+      const int pos = static_cast<int>(std::min<int64_t>(i, val_size - 1));
+      out.values.push_back(is_int32 ? tensor.int_val(pos) : tensor.int64_val(pos));
+    }
+  }
+  out.has_value = true;
+  return true;
+}
+
+bool TensorFlowShapeFolding::EvalPlaceholder(const NodeDef &node, FoldValue &out) const {
+  const auto &input_dims = GetParserContext().input_dims;
+  const auto dims_it = input_dims.find(node.name());
+  if (dims_it != input_dims.end()) {
+    out.shape = dims_it->second;
+  } else {
+    const auto it = node.attr().find("shape");
+    if ((it == node.attr().end()) || !it->second.has_shape() || it->second.shape().unknown_rank()) {
+      return false;
+    }
+    for (const auto &dim : it->second.shape().dim()) {
+      out.shape.push_back(dim.size());
+    }
+  }
+  out.has_shape = std::all_of(out.shape.begin(), out.shape.end(), [](int64_t dim) { return dim >= 0; });
+  return out.has_shape;
+}
+
+bool TensorFlowShapeFolding::EvalStridedSlice(const NodeDef &node, FoldValue &out) const {
+  const FoldValue *input = GetInput(node, 0);
+  const FoldValue *begin = GetInput(node, 1);
+  const FoldValue *end = GetInput(node, 2);
+  const FoldValue *strides = GetInput(node, 3);
+  int64_t begin_value = 0;
+  int64_t end_value = 0;
+  int64_t stride = 0;
+  if ((input == nullptr) || (begin == nullptr) || (end == nullptr) || (strides == nullptr) || !input->has_value ||
+      (input->shape.size() != 1) || !begin->has_value || !GetScalar(begin->values, begin_value) ||
+      !end->has_value || !GetScalar(end->values, end_value) || !strides->has_value ||
+      !GetScalar(strides->values, stride) || (stride == 0)) {
+    return false;
+  }
+  if ((GetIntAttr(node, "ellipsis_mask", 0) != 0) || (GetIntAttr(node, "new_axis_mask", 0) != 0)) {
+    return false;
+  }
+
+  const int64_t size = static_cast<int64_t>(input->values.size());
+  out.has_value = true;
+  out.has_shape = true;
+  out.dtype = input->dtype;
+  out.from_shape = input->from_shape;
+  if ((GetIntAttr(node, "shrink_axis_mask", 0) & 1) != 0) {
+    const int64_t pos = (begin_value < 0) ? (begin_value + size) : begin_value;
+    if ((pos < 0) || (pos >= size)) {
+      return false;
+    }
+    out.values.push_back(input->values[pos]);
+    return true;
+  }
+
+  auto canonical = [size, stride](int64_t value, bool masked, bool is_begin) -> int64_t {
+    if (masked) {
+      return is_begin ? ((stride > 0) ? 0 : (size - 1)) : ((stride > 0) ? size : -1);
+    }
+    value = (value < 0) ? (value + size) : value;
+    return (stride > 0) ? std::min(std::max<int64_t>(value, 0), size)
+                        : std::min(std::max<int64_t>(value, -1), size - 1);
+  };
+  const int64_t first = canonical(begin_value, (GetIntAttr(node, "begin_mask", 0) & 1) != 0, true);
+  const int64_t last = canonical(end_value, (GetIntAttr(node, "end_mask", 0) & 1) != 0, false);
+  for (int64_t pos = first; (stride > 0) ? (pos < last) : (pos > last); pos += stride) {
+    out.values.push_back(input->values[pos]);
+  }
+  out.shape.push_back(static_cast<int64_t>(out.values.size()));
+  return true;
+}
+
+bool TensorFlowShapeFolding::EvalPack(const NodeDef &node, FoldValue &out) const {
+  const int num = DataInputSize(node);
+  if ((num == 0) || (GetIntAttr(node, "axis", 0) != 0)) {
+    return false;
+  }
+  for (int i = 0; i < num; ++i) {
+    const FoldValue *input = GetInput(node, i);
+    if ((input == nullptr) || !input->has_value || (input->shape.size() > 1)) {
+      return false;
+    }
+    if (i == 0) {
+      out.dtype = input->dtype;
+      out.shape.push_back(num);
+      out.shape.insert(out.shape.end(), input->shape.begin(), input->shape.end());
+    } else if ((input->dtype != out.dtype) || (input->shape.size() + 1 != out.shape.size()) ||
+               !std::equal(input->shape.begin(), input->shape.end(), out.shape.begin() + 1)) {
+      return false;
+    }
+    out.values.insert(out.values.end(), input->values.begin(), input->values.end());
+    out.from_shape = out.from_shape || input->from_shape;
+  }
+  out.has_shape = true;
+  out.has_value = true;
+  return true;
+}
+
+bool TensorFlowShapeFolding::EvalConcat(const NodeDef &node, FoldValue &out) const {
+  // the axis is the last data input of ConcatV2
+  const int num = DataInputSize(node) - 1;
+  const FoldValue *axis = GetInput(node, num);
+  int64_t axis_value = 0;
+  if ((num <= 0) || (axis == nullptr) || !axis->has_value || !GetScalar(axis->values, axis_value) ||
+      ((axis_value != 0) && (axis_value != -1))) {
+    return false;
+  }
+  for (int i = 0; i < num; ++i) {
+    const FoldValue *input = GetInput(node, i);
+    if ((input == nullptr) || !input->has_value || (input->shape.size() != 1) ||
+        ((i > 0) && (input->dtype != out.dtype))) {
+      return false;
+    }
+    out.dtype = input->dtype;
+    out.values.insert(out.values.end(), input->values.begin(), input->values.end());
+    out.from_shape = out.from_shape || input->from_shape;
+  }
+  out.shape.push_back(static_cast<int64_t>(out.values.size()));
+  out.has_shape = true;
+  out.has_value = true;
+  return true;
+}
+
+bool TensorFlowShapeFolding::EvalBinary(const NodeDef &node, FoldValue &out) const {
+  const FoldValue *lhs = GetInput(node, 0);
+  const FoldValue *rhs = GetInput(node, 1);
+  if ((lhs == nullptr) || (rhs == nullptr) || !lhs->has_value || !rhs->has_value || (lhs->dtype != rhs->dtype)) {
+    return false;
+  }
+  // equal shapes or broadcasting of a single element
+  const bool lhs_single = (lhs->values.size() == 1) && (lhs->shape.size() <= rhs->shape.size());
+  const bool rhs_single = (rhs->values.size() == 1) && (rhs->shape.size() <= lhs->shape.size());
+  if (lhs->shape == rhs->shape) {
+    out.shape = lhs->shape;
+  } else if (lhs_single) {
+    out.shape = rhs->shape;
+  } else if (rhs_single) {
+    out.shape = lhs->shape;
+  } else {
+    return false;
+  }
+
+  const size_t size = std::max(lhs->values.size(), rhs->values.size());
+  out.values.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t lhs_value = lhs->values[(lhs->values.size() == 1) ? 0 : i];
+    const int64_t rhs_value = rhs->values[(rhs->values.size() == 1) ? 0 : i];
+    if (!CalcBinary(node.op(), lhs_value, rhs_value, out.values[i])) {
+      return false;
+    }
+  }
+  out.dtype = lhs->dtype;
+  out.from_shape = lhs->from_shape || rhs->from_shape;
+  out.has_shape = true;
+  out.has_value = FitsType(out.dtype, out.values);
+  return out.has_value;
+}
+
+bool TensorFlowShapeFolding::EvalProd(const NodeDef &node, FoldValue &out) const {
+  const FoldValue *input = GetInput(node, 0);
+  const FoldValue *axis = GetInput(node, 1);
+  int64_t axis_value = 0;
+  if ((input == nullptr) || (axis == nullptr) || !input->has_value || (input->shape.size() != 1) ||
+      !axis->has_value || !GetScalar(axis->values, axis_value) || ((axis_value != 0) && (axis_value != -1))) {
+    return false;
+  }
+  int64_t product = 1;
+  for (const int64_t value : input->values) {
+    if (!InOperandRange(product) || !CalcBinary("Mul", product, value, product)) {
+      return false;
+    }
+  }
+  out.values.push_back(product);
+  if (GetIntAttr(node, "keep_dims", 0) != 0) {
+    out.shape.push_back(1);
+  }
+  out.dtype = input->dtype;
+  out.from_shape = input->from_shape;
+  out.has_shape = true;
+  out.has_value = FitsType(out.dtype, out.values);
+  return out.has_value;
+}
+
+bool TensorFlowShapeFolding::EvalGather(const NodeDef &node, FoldValue &out) const {
+  const FoldValue *params = GetInput(node, 0);
+  const FoldValue *indices = GetInput(node, 1);
+  if ((params == nullptr) || (indices == nullptr) || !params->has_value || (params->shape.size() != 1) ||
+      !indices->has_value || (GetIntAttr(node, "batch_dims", 0) != 0)) {
+    return false;
+  }
+  if (node.op() == "GatherV2") {
+    const FoldValue *axis = GetInput(node, 2);
+    int64_t axis_value = 0;
+    if ((axis == nullptr) || !axis->has_value || !GetScalar(axis->values, axis_value) ||
+        ((axis_value != 0) && (axis_value != -1))) {
+      return false;
+    }
+  }
+  const int64_t size = static_cast<int64_t>(params->values.size());
+  for (const int64_t index : indices->values) {
+    if ((index < 0) || (index >= size)) {
+      return false;
+    }
+    out.values.push_back(params->values[index]);
+  }
+  out.shape = indices->shape;
+  out.dtype = params->dtype;
+  out.from_shape = params->from_shape;
+  out.has_shape = true;
+  out.has_value = true;
+  return true;
+}
+
+bool TensorFlowShapeFolding::EvalReshape(const NodeDef &node, FoldValue &out) const {
+  const FoldValue *tensor = GetInput(node, 0);
+  const FoldValue *shape = GetInput(node, 1);
+  if ((tensor == nullptr) || (shape == nullptr) || !shape->has_value || (shape->shape.size() > 1)) {
+    return false;
+  }
+  int64_t known = 1;
+  int unknown_pos = -1;
+  for (size_t i = 0; i < shape->values.size(); ++i) {
+    const int64_t dim = shape->values[i];
+    if ((dim == -1) && (unknown_pos < 0)) {
+      unknown_pos = static_cast<int>(i);
+    } else if ((dim < 0) || ((dim > 0) && (known > std::numeric_limits<int64_t>::max() / dim))) {
+      return false;
+    } else {
+      known *= dim;
+    }
+  }
+  out.shape = shape->values;
+  if (unknown_pos >= 0) {
+    int64_t count = 0;
+    if (!tensor->has_shape || !ElementCount(tensor->shape, count) || (known == 0) || (count % known != 0)) {
+      return false;
+    }
+    out.shape[unknown_pos] = count / known;
+  }
+  out.has_shape = true;
+  int64_t count = 0;
+  if (tensor->has_value && ElementCount(out.shape, count) && (static_cast<size_t>(count) == tensor->values.size())) {
+    out.has_value = true;
+    out.values = tensor->values;
+    out.dtype = tensor->dtype;
+    out.from_shape = tensor->from_shape;
+  }
+  return true;
+}
+
+bool TensorFlowShapeFolding::IsFoldable(int index, int output_index) const {
+  const auto &outputs = outputs_[index];
+  if ((output_index < 0) || (static_cast<size_t>(output_index) >= outputs.size())) {
+    return false;
+  }
+  const FoldValue &value = outputs[output_index];
+  const NodeDef &node = graph_def_->node(index);
+  return value.has_value && value.from_shape && (node.op() != "Const") && !keep_node_(node.name());
+}
+
+void TensorFlowShapeFolding::SetConst(const FoldValue &value, NodeDef &node) const {
+  // data inputs are no longer needed, control dependencies are kept
+  std::vector<std::string> control_inputs;
+  for (const auto &input : node.input()) {
+    if (!input.empty() && (input[0] == '^')) {
+      control_inputs.push_back(input);
+    }
+  }
+  node.clear_input();
+  for (auto &input : control_inputs) {
+    node.add_input(std::move(input));
+  }
+  node.set_op("Const");
+  node.clear_attr();
+  auto &attr = *node.mutable_attr();
+  attr["dtype"].set_type(value.dtype);
+  TensorProto *tensor = attr["value"].mutable_tensor();
+  tensor->set_dtype(value.dtype);
+  for (const int64_t dim : value.shape) {
+    tensor->mutable_tensor_shape()->add_dim()->set_size(dim);
+  }
+  for (const int64_t element : value.values) {
+    if (value.dtype == domi::tensorflow::DT_INT32) {
+      tensor->add_int_val(static_cast<int32_t>(element));
+    } else {
+      tensor->add_int64_val(element);
+    }
+  }
+}
+
+int TensorFlowShapeFolding::ReplaceFoldedNodes() {
+  const int node_size = graph_def_->node_size();
+  TfInputName input_name;
+  std::string name;
+  auto count_consumers = [this, &input_name, &name](std::vector<int> &consumer_num) {
+    consumer_num.assign(graph_def_->node_size(), 0);
+    for (const auto &node : graph_def_->node()) {
+      for (const auto &input : node.input()) {
+        if (!TensorFlowUtil::ParseInputName(input, input_name)) {
+          continue;
+        }
+        input_name.AssignName(name);
+        const auto it = node_index_.find(name);
+        if (it != node_index_.end()) {
+          ++consumer_num[it->second];
+        }
+      }
+    }
+  };
+  std::vector<int> consumers_before;
+  count_consumers(consumers_before);
+  std::set<std::pair<int, int32_t>> used_shape_n_outputs;
+  for (const auto &node : graph_def_->node()) {
+    for (const auto &input : node.input()) {
+      if (!TensorFlowUtil::ParseInputName(input, input_name) || input_name.control) {
+        continue;
+      }
+      input_name.AssignName(name);
+      const auto it = node_index_.find(name);
+      if ((it != node_index_.end()) && (graph_def_->node(it->second).op() == "ShapeN")) {
+        (void)used_shape_n_outputs.emplace(it->second, input_name.index);
+      }
+    }
+  }
+
+  int folded_num = 0;
+  std::vector<bool> folded(node_size, false);
+  // each folded output of a ShapeN gets its own Const, consumers of "name:k" are relinked to it
+  std::map<std::string, std::map<int32_t, std::string>> shape_n_outputs;
+  std::vector<NodeDef> new_consts;
+  for (int i = 0; i < node_size; ++i) {
+    NodeDef *node = graph_def_->mutable_node(i);
+    if (node->op() != "ShapeN") {
+      if (IsFoldable(i, 0)) {
+        PARSER_LOGD("[TF Parser] Fold node %s(%s) to Const.", node->name().c_str(), node->op().c_str());
+        SetConst(outputs_[i][0], *node);
+        folded[i] = true;
+        ++folded_num;
+      }
+      continue;
+    }
+    for (size_t k = 0; k < outputs_[i].size(); ++k) {
+      if ((used_shape_n_outputs.count(std::make_pair(i, static_cast<int32_t>(k))) == 0) ||
+          !IsFoldable(i, static_cast<int>(k))) {
+        continue;
+      }
+      std::string const_name = node->name() + kShapeNFoldedSuffix + std::to_string(k);
+      while (node_index_.count(const_name) > 0) {
+        const_name += "_";
+      }
+      PARSER_LOGD("[TF Parser] Fold output %zu of node %s to Const %s.", k, node->name().c_str(),
+                  const_name.c_str());
+      NodeDef const_node;
+      const_node.set_name(const_name);
+      const_node.set_device(node->device());
+      SetConst(outputs_[i][k], const_node);
+      node_index_.emplace(const_name, node_size + static_cast<int>(new_consts.size()));
+      new_consts.push_back(std::move(const_node));
+      shape_n_outputs[node->name()][static_cast<int32_t>(k)] = const_name;
+      folded[i] = true;
+      ++folded_num;
+    }
+  }
+  if (folded_num == 0) {
+    return 0;
+  }
+
+  if (!shape_n_outputs.empty()) {
+    for (auto &node : *graph_def_->mutable_node()) {
+      for (auto &input : *node.mutable_input()) {
+        if (!TensorFlowUtil::ParseInputName(input, input_name) || input_name.control) {
+          continue;
+        }
+        const auto node_it = shape_n_outputs.find(input_name.Name());
+        if (node_it == shape_n_outputs.end()) {
+          continue;
+        }
+        const auto output_it = node_it->second.find(input_name.index);
+        if (output_it != node_it->second.end()) {
+          input = output_it->second;
+        }
+      }
+    }
+    for (auto &const_node : new_consts) {
+      *graph_def_->add_node() = std::move(const_node);
+    }
+    // the new constants have consumers, they are removed like the other folded nodes once those are folded too
+    folded.resize(graph_def_->node_size(), true);
+    consumers_before.resize(graph_def_->node_size(), 1);
+  }
+
+  // folded nodes and constants that were only consumed by folded nodes lose all their consumers
+  std::vector<int> consumers_after;
+  count_consumers(consumers_after);
+  const auto &out_nodes_map = GetParserContext().out_nodes_map;
+  // constants inside a fusion scope are kept like the nodes that are not folded there
+  auto removable = [this, &folded, &consumers_before, &consumers_after, &out_nodes_map](int index) {
+    const NodeDef &node = graph_def_->node(index);
+    return (folded[index] || (node.op() == "Const")) && (consumers_before[index] > 0) &&
+           (consumers_after[index] == 0) && (out_nodes_map.count(node.name()) == 0) && !keep_node_(node.name());
+  };
+  std::vector<bool> removed(graph_def_->node_size(), false);
+  std::vector<int> stack;
+  for (int i = 0; i < graph_def_->node_size(); ++i) {
+    if (removable(i)) {
+      stack.push_back(i);
+    }
+  }
+  while (!stack.empty()) {
+    const int index = stack.back();
+    stack.pop_back();
+    if (removed[index]) {
+      continue;
+    }
+    removed[index] = true;
+    for (const auto &input : graph_def_->node(index).input()) {
+      if (!TensorFlowUtil::ParseInputName(input, input_name)) {
+        continue;
+      }
+      const auto it = node_index_.find(input_name.Name());
+      if ((it != node_index_.end()) && (--consumers_after[it->second] == 0) &&
+          removable(it->second)) {
+        stack.push_back(it->second);
+      }
+    }
+  }
+
+  int kept = 0;
+  for (int i = 0; i < graph_def_->node_size(); ++i) {
+    if (!removed[i]) {
+      if (kept != i) {
+        graph_def_->mutable_node()->SwapElements(kept, i);
+      }
+      ++kept;
+    } else {
+      PARSER_LOGD("[TF Parser] Remove node %s which is only used by folded nodes.",
+                  graph_def_->node(i).name().c_str());
+    }
+  }
+  graph_def_->mutable_node()->DeleteSubrange(kept, graph_def_->node_size() - kept);
+  return folded_num;
+}
+}  // namespace ge
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_TENSORFLOW_TENSORFLOW_SHAPE_FOLDING_H_
+#define PARSER_TENSORFLOW_TENSORFLOW_SHAPE_FOLDING_H_
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "external/ge/ge_api_error_codes.h"
+#include "proto/tensorflow/graph.pb.h"
+
+namespace ge {
+/**
+ * @ingroup domi_omg
+ * @brief Evaluates the integer subgraphs fed by Shape, ShapeN, Size and Rank once the shapes of their inputs are
+ *        known from the user input dims or from Const nodes, and replaces them by Const nodes before the nodes
+ *        are parsed. Enabled by the parser option shape_folding.
+ */
+class TensorFlowShapeFolding {
+ public:
+  // Nodes the predicate returns true for are never folded, e.g. nodes of scope fusion results
+  using KeepNodeFn = std::function<bool(const std::string &node_name)>;
+
+  TensorFlowShapeFolding(domi::tensorflow::GraphDef *graph_def, KeepNodeFn keep_node)
+      : graph_def_(graph_def), keep_node_(std::move(keep_node)) {}
+  ~TensorFlowShapeFolding() = default;
+
+  /**
+   * @ingroup domi_omg
+   * @brief Fold the graph, the nodes only used by folded nodes are removed
+   * @return SUCCESS
+   */
+  Status Run();
+
+ private:
+  struct FoldValue {
+    bool has_shape = false;
+    std::vector<int64_t> shape;
+    // integer elements in row major order, shape is the shape of the value
+    bool has_value = false;
+    domi::tensorflow::DataType dtype = domi::tensorflow::DT_INVALID;
+    std::vector<int64_t> values;
+    // computed from a Shape, ShapeN, Size or Rank result
+    bool from_shape = false;
+  };
+
+  void SortNodes(std::vector<int> &order) const;
+  const FoldValue *GetInput(const domi::tensorflow::NodeDef &node, int input_index) const;
+  void EvalNode(int index);
+  bool EvalConst(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalPlaceholder(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalStridedSlice(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalPack(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalConcat(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalBinary(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalProd(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalGather(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool EvalReshape(const domi::tensorflow::NodeDef &node, FoldValue &out) const;
+  bool IsFoldable(int index, int output_index) const;
+  void SetConst(const FoldValue &value, domi::tensorflow::NodeDef &node) const;
+  int ReplaceFoldedNodes();
+
+  domi::tensorflow::GraphDef *graph_def_;
+  KeepNodeFn keep_node_;
+  std::unordered_map<std::string, int> node_index_;
+  // values of every output of every node, indexed like graph_def_->node()
+  std::vector<std::vector<FoldValue>> outputs_;
+};
+}  // namespace ge
+
+#endif  // PARSER_TENSORFLOW_TENSORFLOW_SHAPE_FOLDING_H_
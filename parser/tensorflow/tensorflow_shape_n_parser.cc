@@ -150,5 +150,5 @@ Status TensorFlowShapeNParser::PostParseParams(const domi::tensorflow::NodeDef *
   return SUCCESS;
 }
 
-REGISTER_OP_PARSER_CREATOR(TENSORFLOW, SHAPEN, TensorFlowShapeNParser);
+REGISTER_STATELESS_OP_PARSER_CREATOR(TENSORFLOW, SHAPEN, TensorFlowShapeNParser);
 }  // namespace ge
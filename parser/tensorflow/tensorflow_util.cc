@@ -15,7 +15,9 @@
  */
 
 #include "parser/tensorflow/tensorflow_util.h"
+#include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
@@ -45,6 +47,54 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool TensorFlowUtil::FindAttrVa
   return false;
 }
 
+namespace {
+// Same result as std::stoi on the index: leading spaces and a sign are allowed, trailing characters ignored
+bool ParseInputIndex(const char *begin, const char *end, int32_t &index) {
+  const char *pos = begin;
+  while ((pos < end) && (isspace(static_cast<unsigned char>(*pos)) != 0)) {
+    ++pos;
+  }
+  bool negative = false;
+  if ((pos < end) && ((*pos == '+') || (*pos == '-'))) {
+    negative = (*pos == '-');
+    ++pos;
+  }
+  const char *digits = pos;
+  const int64_t limit = static_cast<int64_t>(INT32_MAX) + 1;
+  int64_t value = 0;
+  while ((pos < end) && (*pos >= '0') && (*pos <= '9')) {
+    value = value * 10 + (*pos - '0');
+    if (value > limit) {
+      return false;
+    }
+    ++pos;
+  }
+  if ((pos == digits) || (!negative && (value == limit))) {
+    return false;
+  }
+  index = static_cast<int32_t>(negative ? -value : value);
+  return true;
+}
+}  // namespace
+
+bool TensorFlowUtil::ParseInputName(const string &input, TfInputName &input_name) {
+  const char *begin = input.data();
+  const char *end = begin + input.size();
+  input_name.control = (begin < end) && (*begin == '^');
+  if (input_name.control) {
+    ++begin;
+  }
+  const char *colon = static_cast<const char *>(memchr(begin, ':', static_cast<size_t>(end - begin)));
+  input_name.name = begin;
+  input_name.index = 0;
+  if (colon == nullptr) {
+    input_name.name_len = static_cast<size_t>(end - begin);
+    return true;
+  }
+  input_name.name_len = static_cast<size_t>(colon - begin);
+  return ParseInputIndex(colon + 1, end, input_name.index);
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY domi::Status TensorFlowUtil::CheckAttrHasType(
     const domi::tensorflow::AttrValue &attr_value, const string &type) {
   uint32_t num_set = 0;
@@ -132,8 +132,37 @@ static const uint32_t TENSORFLOW_NORMAL_WEIGHT_SIZE_RESHAPE = 1;
 static const uint32_t TENSORFLOW_NORMAL_INPUT_TENSOR_FLAG = 1;
 static const uint32_t TENSORFLOW_NORMAL_OUTPUT_TENSOR_FLAG = 2;
 
+/**
+ * @ingroup domi_omg
+ * @brief A NodeDef input "^name", "name:index" or "name" split in place, name points into the input string
+ */
+struct TfInputName {
+  const char *name = nullptr;
+  size_t name_len = 0;
+  int32_t index = 0;
+  bool control = false;
+
+  bool NameEquals(const string &other) const {
+    return (other.size() == name_len) && (other.compare(0, name_len, name, name_len) == 0);
+  }
+  // assign into a reused string, no allocation once its capacity is reached
+  void AssignName(string &str) const { str.assign(name, name_len); }
+  string Name() const { return string(name, name_len); }
+};
+
 class TensorFlowUtil {
  public:
+  /**
+  * @ingroup domi_omg
+  * @brief split a NodeDef input into node name, output index and control flag without allocation
+  * @param [in] input        input of a NodeDef, must outlive input_name
+  * @param [out] input_name  the split input, index is 0 when the input has no index
+  * @return true             the index is a valid int32 or absent
+  * @return false            the index is invalid, name and control are still set
+  *
+  */
+  static bool ParseInputName(const string &input, TfInputName &input_name);
+
   /**
   * @ingroup domi_omg
   * @brief find the corresponding AttrValue in NodeDef